@@ -0,0 +1,1478 @@
+#define _POSIX_C_SOURCE 200809L // POSIX.1-2008 standardını etkinleştir
+#define _DEFAULT_SOURCE         // usleep için gerekli
+#include <stdio.h>     // snprintf, fopen
+#include <stdlib.h>    // calloc, free, getenv
+#include <string.h>    // memset, strncpy
+#include <unistd.h>    // fork, execvp, sleep
+#include <fcntl.h>     // O_CREAT, O_EXCL, O_RDWR
+#include <sys/mman.h>  // shm_open, mmap, shm_unlink, munmap
+#include <sys/stat.h>  // 0666
+#include <semaphore.h> // sem_open, sem_wait, sem_post, sem_close, sem_unlink
+#include <sys/msg.h>   // msgget, msgsnd, msgrcv
+#include <sys/types.h> // pid_t, key_t
+#include <errno.h>     // error handling
+#include <time.h>      // time
+#include <signal.h>    // kill, SIGTERM
+#include <pthread.h>   // pthread_create, pthread_join
+#include <sched.h>     // sched_yield
+#include <sys/wait.h>  // waitpid
+#include <sys/syscall.h> // SYS_clone3
+#include <fnmatch.h>     // fnmatch (komut glob eşleştirme)
+#include <dirent.h>      // opendir (/proc taraması)
+#include <sys/vfs.h>     // statfs (cgroup2 dosya sistemi kontrolü)
+#include <sys/resource.h> // setrlimit, setpriority (cgroup yoksa yedek yol)
+#include <linux/magic.h> // CGROUP2_SUPER_MAGIC
+#include <linux/sched.h> // struct clone_args, CLONE_INTO_CGROUP
+#include "procx_internal.h"
+
+// --- SABITLER ---
+
+// Proje için gerekli dosya isimleri ve anahtarlar
+#define SHM_NAME "/procx_shm"      // Shared Memory Adı (POSIX standardı) [cite: 1925]
+#define SEM_NAME "/procx_sem"      // Semaphore Adı [cite: 1925]
+#define MQ_KEY_FILE "procx_mq_key" // Message Queue ftok dosyası (Lab 8 mantığı) [cite: 1116]
+#define PROJ_ID 65                 // ftok proje ID
+#define WATCHDOG_INTERVAL 1        // Watchdog kontrol aralığı (saniye)
+#define CGROUP_ROOT "/sys/fs/cgroup/procx" // cgroup v2 kök dizini (PROCX_CGROUP_ROOT ile değiştirilebilir)
+#define CPU_PERIOD_US 100000       // cpu.max periyodu (mikrosaniye)
+
+// --- OLAYLAR ---
+
+static void emit_event(procx_t *h, const ProcessEvent *ev) // Olayı tüm abonelerin kuyruğuna ekle
+{
+    pthread_mutex_lock(&h->sub_lock);
+    for (procx_sub_t *sub = h->subs; sub != NULL; sub = sub->next)
+    {
+        pthread_mutex_lock(&sub->lock);
+        if (sub->count == EVENT_QUEUE_SIZE) // Kuyruk doluysa en eski olayı düşür
+        {
+            sub->head = (sub->head + 1) % EVENT_QUEUE_SIZE;
+            sub->count--;
+        }
+        sub->events[(sub->head + sub->count) % EVENT_QUEUE_SIZE] = *ev;
+        sub->count++;
+        pthread_cond_signal(&sub->cond);
+        pthread_mutex_unlock(&sub->lock);
+    }
+    pthread_mutex_unlock(&h->sub_lock);
+}
+
+procx_sub_t *procx_subscribe(procx_t *h)
+{
+    procx_sub_t *sub = calloc(1, sizeof(*sub));
+    if (sub == NULL)
+        return NULL;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sub->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&sub->lock, NULL);
+    sub->h = h;
+
+    pthread_mutex_lock(&h->sub_lock);
+    sub->next = h->subs;
+    h->subs = sub;
+    pthread_mutex_unlock(&h->sub_lock);
+    return sub;
+}
+
+int procx_next_event(procx_sub_t *sub, ProcessEvent *ev, int timeout_ms)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+    deadline.tv_nsec %= 1000000000L;
+
+    pthread_mutex_lock(&sub->lock);
+    while (sub->count == 0)
+    {
+        if (timeout_ms < 0)
+            pthread_cond_wait(&sub->cond, &sub->lock);
+        else if (pthread_cond_timedwait(&sub->cond, &sub->lock, &deadline) == ETIMEDOUT)
+            break;
+    }
+
+    int got = 0;
+    if (sub->count > 0)
+    {
+        *ev = sub->events[sub->head];
+        sub->head = (sub->head + 1) % EVENT_QUEUE_SIZE;
+        sub->count--;
+        got = 1;
+    }
+    pthread_mutex_unlock(&sub->lock);
+    return got;
+}
+
+static void free_subscription(procx_sub_t *sub)
+{
+    pthread_cond_destroy(&sub->cond);
+    pthread_mutex_destroy(&sub->lock);
+    free(sub);
+}
+
+void procx_unsubscribe(procx_sub_t *sub)
+{
+    procx_t *h = sub->h;
+
+    pthread_mutex_lock(&h->sub_lock);
+    for (procx_sub_t **link = &h->subs; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == sub)
+        {
+            *link = sub->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&h->sub_lock);
+    free_subscription(sub);
+}
+
+// --- KİLİT ---
+
+static void begin_write(SharedData *data) // Seqlock: okuyuculara yazma sürdüğünü bildir (kilit tutulmalı, tablo değişmeden önce)
+{
+    if ((data->seq & 1) == 0) // Aynı kilit içinde ikinci yazma ya da ölen sahibin yarım kalan yazması
+        data->seq++;
+    __sync_synchronize();
+}
+
+static void shared_lock(procx_t *h) // Robust mutex kilitle; sahibi kilidi tutarken öldüyse çekirdek kilidi bize devreder
+{ // Sayaca dokunmaz: sadece okuyan kilit sahipleri kopyasız okuyucuları bekletmez
+    SharedData *data = h->shared_data;
+
+    int res = pthread_mutex_lock(&data->lock);
+    if (res == EOWNERDEAD)
+    {
+        pid_t owner = data->lock_owner; // Ölen sahip (PID'ini yazamadan öldüyse 0)
+        pthread_mutex_consistent(&data->lock);
+        data->lock_owner = getpid(); // Yarım kalan yazmanın tek sayacı unlock'ta kapanır
+        clock_gettime(CLOCK_MONOTONIC, &data->lock_recovered_at); // Diğer terminaller devralma anını ölçebilsin
+        __sync_synchronize();
+        data->lock_recoveries++;
+        ProcessEvent ev = {.type = PROCX_EVENT_LOCK_RECOVERED, .pid = owner};
+        emit_event(h, &ev);
+        return;
+    }
+    data->lock_owner = getpid();
+}
+
+static void shared_unlock(procx_t *h) // Mutex aç
+{
+    __sync_synchronize();
+    if (h->shared_data->seq & 1)
+        h->shared_data->seq++; // Çift değer: yazma bitti
+    h->shared_data->lock_owner = 0;
+    pthread_mutex_unlock(&h->shared_data->lock);
+}
+
+void procx_lock(procx_t *h)
+{
+    shared_lock(h);
+}
+
+void procx_unlock(procx_t *h)
+{
+    shared_unlock(h);
+}
+
+const SharedData *procx_table(procx_t *h)
+{
+    return h->shared_data;
+}
+
+// --- KOPYASIZ OKUMA ---
+
+void procx_snapshot_begin(procx_t *h, ProcessSnapshot *snap)
+{
+    snap->table = h->shared_data;
+    snap->index = 0;
+    for (;;)
+    {
+        snap->seq = *(volatile const unsigned int *)&snap->table->seq;
+        if ((snap->seq & 1) == 0)
+            break;
+        sched_yield(); // Yazma sürüyor
+    }
+    __sync_synchronize();
+}
+
+const ProcessInfo *procx_snapshot_next(ProcessSnapshot *snap)
+{
+    while (snap->index < PROCX_MAX_PROCESSES)
+    {
+        const ProcessInfo *proc = &snap->table->processes[snap->index++];
+        if (proc->is_active)
+            return proc;
+    }
+    return NULL;
+}
+
+int procx_snapshot_end(const ProcessSnapshot *snap)
+{
+    __sync_synchronize();
+    if (*(volatile const unsigned int *)&snap->table->seq != snap->seq)
+    {
+        errno = EAGAIN;
+        return -1;
+    }
+    return 0;
+}
+
+// --- SİNYALLER VE KAYNAK KULLANIMI ---
+
+static int job_pidfd(procx_t *h, pid_t pid) // Bu terminalin başlattığı işin pidfd'si, yoksa -1 (kilit tutulmalı)
+{
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+        if (h->pidfds[i] >= 0 && h->pidfd_pids[i] == pid)
+            return h->pidfds[i];
+    return -1;
+}
+
+static void prune_pidfds(procx_t *h) // Slotu boşalan veya başka işe geçen pidfd'leri kapat (kilit tutulmalı)
+{
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        ProcessInfo *proc = &h->shared_data->processes[i];
+        if (h->pidfds[i] >= 0 && (!proc->is_active || proc->pid != h->pidfd_pids[i]))
+        {
+            close(h->pidfds[i]);
+            h->pidfds[i] = -1;
+        }
+    }
+}
+
+static int send_signal(procx_t *h, pid_t pid, int sig) // Sinyali işin process grubuna gönder (/bin/sh ve başlattığı komutlar) (kilit tutulmalı)
+{
+#ifdef SYS_pidfd_send_signal
+    int pidfd = job_pidfd(h, pid);
+    if (pidfd >= 0)
+    {
+        // pidfd spawn anında alındı: PID yeniden kullanılmış olsa da sinyal bu işin liderine gider
+        if (syscall(SYS_pidfd_send_signal, pidfd, sig, NULL, 0) == 0)
+        {
+            kill(-pid, sig); // Lider toplanmadıkça PGID başka gruba verilemez; shell'in başlattıkları
+            return 0;
+        }
+        if (errno == ESRCH) // Lider toplandı; çıplak PID'e değil sadece grupta kalanlara gönder
+            return kill(-pid, sig);
+        // ENOSYS: çekirdek desteklemiyor, kill yoluna düş
+    }
+#endif
+    if (kill(-pid, sig) == 0)
+        return 0;
+    if (errno != ESRCH)
+        return -1;
+    return kill(pid, sig); // Child henüz setsid/setpgid yapmadı
+}
+
+static int group_exited(pid_t pid) // İşin process grubunda canlı (veya toplanmamış) üye kalmadı mı?
+{
+    return kill(-pid, 0) == -1 && errno == ESRCH;
+}
+
+static int request_termination(procx_t *h, ProcessInfo *proc) // SIGTERM gönder, SIGKILL'i watchdog'a bırak (kilit tutulmalı)
+{
+    if (proc->term_sent_time != 0) // Zaten sonlandırma sürecinde
+        return 0;
+
+    if (send_signal(h, proc->pid, SIGTERM) == -1)
+        return -1;
+
+    proc->term_sent_time = time(NULL); // Slot PROCX_RUNNING kalır, çıkış monitor tarafından onaylanır
+    return 0;
+}
+
+static int read_group_usage(pid_t pgid, long *cpu_sec, long *rss_kb) // /proc üzerinden process grubunun toplam CPU ve RSS kullanımını oku
+{
+    DIR *dir = opendir("/proc");
+    if (!dir)
+        return -1;
+
+    unsigned long long ticks = 0;
+    long pages = 0;
+    int members = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            continue;
+
+        char path[288];
+        char buf[1024];
+        snprintf(path, sizeof(path), "/proc/%s/stat", entry->d_name);
+        FILE *fp = fopen(path, "r");
+        if (!fp)
+            continue; // Bu arada çıktı
+        size_t n = fread(buf, 1, sizeof(buf) - 1, fp);
+        fclose(fp);
+        buf[n] = '\0';
+
+        // Komut adı boşluk içerebilir, son ')' sonrasından başla
+        // Alanlar: state ppid pgrp ... utime stime cutime cstime ... rss
+        char *p = strrchr(buf, ')');
+        int pgrp;
+        unsigned long utime, stime;
+        long cutime, cstime, rss;
+        if (!p || sscanf(p + 1, " %*c %*d %d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %ld %ld %*d %*d %*d %*d %*u %*u %ld",
+                         &pgrp, &utime, &stime, &cutime, &cstime, &rss) != 6 || pgrp != pgid)
+            continue;
+
+        ticks += utime + stime + cutime + cstime; // Toplanmış çocukların süresi cutime/cstime içinde
+        pages += rss;
+        members++;
+    }
+    closedir(dir);
+
+    if (members == 0)
+        return -1;
+    *cpu_sec = (long)(ticks / sysconf(_SC_CLK_TCK));
+    *rss_kb = pages * (sysconf(_SC_PAGESIZE) / 1024);
+    return 0;
+}
+
+static void terminate_and_reap(procx_t *h, pid_t *pids, int count) // SIGTERM gönder, süre dolunca SIGKILL ile bitir ve topla (thread'ler durmuş olmalı)
+{
+    for (int i = 0; i < count; i++)
+        send_signal(h, pids[i], SIGTERM);
+
+    int remaining = count;
+    for (int waited = 0; remaining > 0 && waited < PROCX_GRACE_PERIOD * 10; waited++)
+    {
+        usleep(100000); // 100 ms
+        for (int i = 0; i < count; i++)
+        {
+            // Lider çıktı (veya zaten toplandı) ve grupta kimse kalmadı
+            if (pids[i] != 0 && waitpid(pids[i], NULL, WNOHANG) != 0 && group_exited(pids[i]))
+            {
+                pids[i] = 0;
+                remaining--;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (pids[i] != 0) // SIGTERM'i yok sayan processler
+        {
+            send_signal(h, pids[i], SIGKILL);
+            waitpid(pids[i], NULL, 0); // Lider zaten toplandıysa ECHILD
+        }
+    }
+}
+
+// --- CGROUP V2 ---
+
+const char *procx_cgroup_root(void) // cgroup kök dizini
+{
+    const char *root = getenv("PROCX_CGROUP_ROOT");
+    return (root && *root) ? root : CGROUP_ROOT;
+}
+
+static void restore_foreground(procx_t *h) // Terminal ön planını attached işten geri al
+{
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGTTOU);
+    pthread_sigmask(SIG_BLOCK, &block, &old);
+    tcsetpgrp(STDIN_FILENO, getpgrp());
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    h->fg_job = 0;
+}
+
+static int write_cgroup_file(const char *dir, const char *file, const char *value) // cgroup arayüz dosyasına yaz
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, file);
+
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd == -1)
+        return -1;
+    ssize_t res = write(fd, value, strlen(value));
+    close(fd);
+    return res == -1 ? -1 : 0;
+}
+
+static int write_cgroup_file_at(int dir_fd, const char *file, const char *value) // cgroup dizin fd'si üzerinden yaz
+{
+    int fd = openat(dir_fd, file, O_WRONLY | O_CLOEXEC);
+    if (fd == -1)
+        return -1;
+    ssize_t res = write(fd, value, strlen(value));
+    close(fd);
+    return res == -1 ? -1 : 0;
+}
+
+static int cgroup_spec_valid(const CgroupSpec *spec) // Etiket kök altında tek bir dizin adı olmalı, job-* yaprakları süpürmeye ayrılmış
+{
+    if (memchr(spec->group, '\0', sizeof(spec->group)) == NULL)
+        return 0;
+    if (strchr(spec->group, '/') != NULL || strcmp(spec->group, ".") == 0 || strcmp(spec->group, "..") == 0 ||
+        strncmp(spec->group, "job-", 4) == 0)
+        return 0;
+    return spec->cpu_percent >= 0 && spec->memory_mb >= 0 && spec->io_weight >= 0 && spec->io_weight <= 10000;
+}
+
+static int cgroup_prepare(procx_t *h, const CgroupSpec *spec, char *leaf, size_t leaf_len) // Yaprak cgroup oluştur, dizin fd'sini döndür
+{
+    const char *root = procx_cgroup_root();
+    char parent[512];
+    char dir[512];
+    struct statfs fs;
+
+    // Kök dizinin üst dizini cgroup2 olmalı (v1/hybrid sistemlerde yedek yola düş)
+    strncpy(parent, root, sizeof(parent) - 1);
+    parent[sizeof(parent) - 1] = '\0';
+    char *slash = strrchr(parent, '/');
+    if (slash && slash != parent)
+        *slash = '\0';
+    if (statfs(parent, &fs) == -1 || fs.f_type != CGROUP2_SUPER_MAGIC)
+        return -1;
+
+    if (mkdir(root, 0755) == -1 && errno != EEXIST)
+        return -1;
+    write_cgroup_file(parent, "cgroup.subtree_control", "+cpu +memory +io"); // Zaten açıksa hata önemsiz
+    write_cgroup_file(root, "cgroup.subtree_control", "+cpu +memory +io");
+
+    if (spec->group[0] != '\0')
+        snprintf(leaf, leaf_len, "%s", spec->group); // Etiket başına ortak grup
+    else
+        snprintf(leaf, leaf_len, "job-%d-%d", getpid(), ++h->leaf_seq);
+
+    snprintf(dir, sizeof(dir), "%s/%s", root, leaf);
+    if (mkdir(dir, 0755) == -1 && errno != EEXIST)
+        return -1;
+
+    char value[64];
+    int failed = 0;
+    if (spec->cpu_percent > 0)
+    {
+        snprintf(value, sizeof(value), "%ld %d", spec->cpu_percent * CPU_PERIOD_US / 100, CPU_PERIOD_US);
+        failed |= write_cgroup_file(dir, "cpu.max", value);
+    }
+    if (spec->memory_mb > 0)
+    {
+        snprintf(value, sizeof(value), "%ld", spec->memory_mb * 1024 * 1024);
+        failed |= write_cgroup_file(dir, "memory.max", value);
+    }
+    if (spec->io_weight > 0)
+    {
+        snprintf(value, sizeof(value), "%d", spec->io_weight);
+        failed |= write_cgroup_file(dir, "io.weight", value);
+    }
+
+    int dir_fd = failed ? -1 : open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd == -1)
+    {
+        rmdir(dir); // Boşsa kaldır (etiketli grupta başka process varsa EBUSY)
+        return -1;
+    }
+    return dir_fd;
+}
+
+static void cgroup_release(const char *leaf) // Boşalan yaprak cgroup'u kaldır
+{
+    if (leaf[0] == '\0')
+        return;
+
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s/%s", procx_cgroup_root(), leaf);
+    rmdir(dir); // Etiketli grupta hala process varsa EBUSY ile başarısız olur
+}
+
+static void cgroup_sweep(void) // Sahibi ölmüş (veya bu terminal olan) boş job-* yapraklarını kaldır
+{
+    DIR *dir = opendir(procx_cgroup_root());
+    if (!dir)
+        return;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        int owner;
+        if (sscanf(entry->d_name, "job-%d-", &owner) != 1)
+            continue; // Etiketli gruplar başka namespace'lere ait olabilir
+        if (owner == getpid() || (kill(owner, 0) == -1 && errno == ESRCH))
+            cgroup_release(entry->d_name); // İçinde process varsa EBUSY ile kalır
+    }
+    closedir(dir);
+}
+
+static double read_psi_avg10(const char *leaf, const char *file) // Pressure dosyasından "some avg10" değerini oku
+{
+    char path[512];
+    double avg10 = 0.0;
+    snprintf(path, sizeof(path), "%s/%s/%s", procx_cgroup_root(), leaf, file);
+
+    FILE *fp = fopen(path, "r");
+    if (!fp)
+        return 0.0;
+    if (fscanf(fp, "some avg10=%lf", &avg10) != 1)
+        avg10 = 0.0;
+    fclose(fp);
+    return avg10;
+}
+
+static void apply_rlimit_fallback(const CgroupSpec *spec) // cgroupfs yazılamıyorsa setrlimit ile sınırla (child içinde)
+{
+    if (spec->memory_mb > 0)
+    {
+        struct rlimit rl;
+        rl.rlim_cur = rl.rlim_max = (rlim_t)spec->memory_mb * 1024 * 1024; // RSS yerine adres alanı sınırı
+        setrlimit(RLIMIT_AS, &rl);
+    }
+    if (spec->cpu_percent > 0 && spec->cpu_percent < 100)
+    {
+        // CPU bant genişliği karşılığı yok; öncelik düşürülür (%50 ve altı -> nice 19)
+        setpriority(PRIO_PROCESS, 0, (int)(19 - spec->cpu_percent * 19 / 100));
+    }
+    // io.weight için rlimit karşılığı yok
+}
+
+// --- MESAJLAŞMA ---
+
+static void purge_terminal(procx_t *h, int slot) { // Ölü terminali listeden çıkar ve kuyrukta bekleyen mesajlarını boşalt (kilit tutulmalı)
+    Message stale;
+    pid_t dead = h->shared_data->active_terminals[slot];
+
+    begin_write(h->shared_data);
+    h->shared_data->active_terminals[slot] = 0;
+    h->shared_data->terminal_count--;
+    while (msgrcv(h->msqid, &stale, sizeof(Message) - sizeof(long), dead, IPC_NOWAIT) != -1)
+        ; // Okunmayacak mesajlar kuyruğu doldurmasın
+}
+
+static void broadcast(procx_t *h, Message *msg) { // Mesajı diğer tüm aktif terminallere gönder
+    shared_lock(h);
+    for (int i = 0; i < PROCX_MAX_TERMINALS; i++) {
+        pid_t dest = h->shared_data->active_terminals[i];
+        // Sadece diğer aktif terminallere gönder
+        if (dest != 0 && dest != getpid()) {
+            if (kill(dest, 0) == -1 && errno == ESRCH) { // Temizlik yapmadan ölmüş terminal
+                purge_terminal(h, i);
+                continue;
+            }
+            msg->msg_type = dest; // Hedef PID
+            // Kuyruk doluysa kilidi tutarken bloklanma; bildirimler tavsiye niteliğinde, düşürülebilir
+            msgsnd(h->msqid, msg, message_size(msg), IPC_NOWAIT);
+        }
+    }
+    shared_unlock(h);
+}
+
+static void broadcast_message(procx_t *h, int command, pid_t target_pid) {
+    Message msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.command = command;
+    msg.sender_pid = getpid();
+    msg.target_pid = target_pid;
+
+    broadcast(h, &msg);
+}
+
+static void broadcast_batch(procx_t *h, int command, const pid_t *pids, int count) { // PID listesini tek mesajda gönder
+    Message msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.command = command;
+    msg.sender_pid = getpid();
+    msg.target_count = count;
+    memcpy(msg.targets, pids, count * sizeof(pid_t));
+
+    broadcast(h, &msg);
+}
+
+// --- THREAD'LER ---
+
+static void *monitor_thread(void *arg)
+{
+    procx_t *h = arg;
+    SharedData *shared_data = h->shared_data;
+    int status;
+
+    while (h->running)
+    {
+        sleep(2); // 2 saniye bekle
+
+        shared_lock(h);
+        prune_pidfds(h); // Çıkışı onaylanan işlerin pidfd'leri
+        shared_unlock(h);
+
+        // Dizideki tüm processleri kontrol et
+        for(int i = 0; i < PROCX_MAX_PROCESSES; i++) {
+            shared_lock(h); // Tabloyu kilitle
+
+            // Sınır kontrolü ve aktiflik kontrolü
+            if(!shared_data->processes[i].is_active) {
+                shared_unlock(h); // Hemen serbest bırak
+                continue;
+            }
+
+            pid_t pid = shared_data->processes[i].pid;
+            pid_t owner_pid = shared_data->processes[i].owner_pid;
+            char leaf[64];
+            strncpy(leaf, shared_data->processes[i].cgroup, sizeof(leaf));
+            shared_unlock(h); // Hemen serbest bırak
+
+            int is_dead = 0;
+
+            if (owner_pid == getpid()) {
+                // Kendi processimiz - waitpid ile kontrol et (lider önceki turda toplandıysa ECHILD)
+                // Sadece tablodaki PID'ler toplanır; gömen programın kendi çocuklarına dokunulmaz
+                pid_t waited = waitpid(pid, &status, WNOHANG);
+                if (waited == pid || (waited == -1 && errno == ECHILD)) {
+                    is_dead = 1;
+                }
+            } else {
+                // Başka instance'ın processi - kill(0) ile kontrol et
+                if (kill(pid, 0) == -1 && errno == ESRCH) { // Eğer bir süreç dışarıdan öldürülürse
+                    is_dead = 1;
+                }
+            }
+            // Shell çıksa bile başlattığı komutlar grupta yaşıyorsa iş bitmemiştir
+            if (is_dead && !group_exited(pid)) {
+                is_dead = 0;
+            }
+
+            // Kendi cgroup'umuzdaki canlı process için basınç (PSI) değerlerini tabloya yaz
+            if (!is_dead && owner_pid == getpid() && leaf[0] != '\0') {
+                double psi_cpu = read_psi_avg10(leaf, "cpu.pressure");
+                double psi_memory = read_psi_avg10(leaf, "memory.pressure");
+                double psi_io = read_psi_avg10(leaf, "io.pressure");
+
+                shared_lock(h);
+                for (int j = 0; j < PROCX_MAX_PROCESSES; j++) {
+                    if (shared_data->processes[j].pid == pid && shared_data->processes[j].is_active) {
+                        begin_write(shared_data);
+                        shared_data->processes[j].psi_cpu = psi_cpu;
+                        shared_data->processes[j].psi_memory = psi_memory;
+                        shared_data->processes[j].psi_io = psi_io;
+                        break;
+                    }
+                }
+                shared_unlock(h);
+            }
+
+            // Process öldüyse güncelle
+            if(is_dead) {
+                shared_lock(h);
+
+                // Process'i bul ve güncelle (PID ile ara çünkü index değişmiş olabilir)
+                int found = 0;
+                for(int j = 0; j < PROCX_MAX_PROCESSES; j++) {
+                    if(shared_data->processes[j].pid == pid &&
+                       shared_data->processes[j].is_active) {
+                        begin_write(shared_data);
+                        shared_data->processes[j].status = PROCX_TERMINATED;
+                        shared_data->processes[j].is_active = 0;
+                        found = 1;
+                        break;
+                    }
+                }
+
+                shared_unlock(h);
+
+                if(found) {
+                    cgroup_release(leaf); // Sahibi kapanmış detached işin yaprağını da kaldır
+                    ProcessEvent ev = {.type = PROCX_EVENT_EXITED, .pid = pid, .reaped = (owner_pid == getpid())};
+                    emit_event(h, &ev);
+                    // Terminate mesajı gönder
+                    broadcast_message(h, CMD_TERMINATE, pid);
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static pid_t lowest_live_terminal(procx_t *h) // Sahipsiz slotları devralacak terminal: en küçük canlı PID (kilit tutulmalı)
+{
+    pid_t lowest = 0;
+    for (int i = 0; i < PROCX_MAX_TERMINALS; i++)
+    {
+        pid_t terminal = h->shared_data->active_terminals[i];
+        if (terminal == 0 || (lowest != 0 && terminal > lowest))
+            continue;
+        if (terminal == getpid() || kill(terminal, 0) == 0 || errno != ESRCH)
+            lowest = terminal;
+    }
+    return lowest;
+}
+
+static int is_enforcer(procx_t *h, pid_t owner, pid_t *adopter) // Slotun bütçesini bu terminal mi uygular? (kilit tutulmalı)
+{
+    if (owner == getpid())
+        return 1;
+    if (kill(owner, 0) == 0 || errno != ESRCH) // Sahibi yaşıyor, kendi watchdog'u uygular
+        return 0;
+    if (*adopter == 0) // Tur başına bir kez hesaplanır
+        *adopter = lowest_live_terminal(h);
+    return *adopter == getpid();
+}
+
+static void *watchdog_thread(void *arg) // Kaynak bütçelerini uygulayan iş parçacığı
+{
+    procx_t *h = arg;
+    SharedData *shared_data = h->shared_data;
+
+    while (h->running)
+    {
+        sleep(WATCHDOG_INTERVAL);
+
+        // Her slotu tek terminal örnekler: sahibi, sahibi öldüyse en küçük PID'li canlı terminal
+        pid_t adopter = 0;
+        for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+        {
+            shared_lock(h); // Tabloyu kilitle
+
+            if (!shared_data->processes[i].is_active ||
+                !is_enforcer(h, shared_data->processes[i].owner_pid, &adopter))
+            {
+                shared_unlock(h);
+                continue;
+            }
+
+            pid_t pid = shared_data->processes[i].pid;
+            ResourceLimits limits = shared_data->processes[i].limits;
+            time_t start_time = shared_data->processes[i].start_time;
+            time_t term_sent_time = shared_data->processes[i].term_sent_time;
+            int kill_sent = shared_data->processes[i].kill_sent;
+            shared_unlock(h); // /proc okuması kilit dışında yapılır
+
+            time_t now = time(NULL);
+            const char *reason = NULL;
+            int sig = 0;
+
+            if (term_sent_time != 0)
+            {
+                // Grace period doldu ve process hala yaşıyor - SIGKILL ile bitir
+                if (!kill_sent && difftime(now, term_sent_time) >= PROCX_GRACE_PERIOD)
+                {
+                    sig = SIGKILL;
+                    reason = "grace period expired";
+                }
+            }
+            else
+            {
+                long cpu_sec = 0, rss_kb = 0;
+                int have_usage = (limits.cpu_sec > 0 || limits.rss_kb > 0) &&
+                                 read_group_usage(pid, &cpu_sec, &rss_kb) == 0;
+
+                if (limits.wall_sec > 0 && difftime(now, start_time) >= limits.wall_sec)
+                    reason = "wall time budget exceeded";
+                else if (have_usage && limits.cpu_sec > 0 && cpu_sec >= limits.cpu_sec)
+                    reason = "CPU budget exceeded";
+                else if (have_usage && limits.rss_kb > 0 && rss_kb >= limits.rss_kb)
+                    reason = "RSS budget exceeded";
+
+                if (reason)
+                    sig = SIGTERM;
+            }
+
+            if (!sig)
+                continue;
+
+            shared_lock(h);
+            // Process'i tekrar bul (PID ile ara çünkü durum değişmiş olabilir)
+            int acted = 0;
+            for (int j = 0; j < PROCX_MAX_PROCESSES; j++)
+            {
+                ProcessInfo *proc = &shared_data->processes[j];
+                if (proc->pid != pid || !proc->is_active)
+                    continue;
+
+                begin_write(shared_data);
+                if (sig == SIGTERM)
+                {
+                    acted = (proc->term_sent_time == 0 && request_termination(h, proc) == 0);
+                }
+                else if (!proc->kill_sent && send_signal(h, pid, SIGKILL) == 0) // Sahibi pidfd ile gönderir
+                {
+                    proc->kill_sent = 1;
+                    acted = 1;
+                }
+                break;
+            }
+            shared_unlock(h);
+
+            if (acted)
+            {
+                ProcessEvent ev = {.type = PROCX_EVENT_WATCHDOG, .pid = pid, .signal = sig, .reason = reason};
+                emit_event(h, &ev);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void *ipc_listener_thread(void *arg) // IPC dinleyici iş parçacığı
+{
+    procx_t *h = arg;
+    SharedData *shared_data = h->shared_data;
+    Message msg;
+
+    while (h->running) // Ana döngü
+    {
+        if (msgrcv(h->msqid, &msg, sizeof(Message) - sizeof(long), getpid(), 0) != -1) // Mesaj alındıysa
+        {
+            if (errno == EINTR || !h->running) break; // Kapanış sinyali
+            // Kendi mesajımızı geri yansıtıyorsak (Hot Potato fix)
+            if (msg.sender_pid == getpid())
+            {
+                continue;
+            }
+
+            ProcessEvent ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.pid = msg.target_pid;
+            ev.sender_pid = msg.sender_pid;
+
+            // Mesaj türüne göre işlem yap
+            if (msg.command == CMD_START) // START komutu
+            {
+                ev.type = PROCX_EVENT_REMOTE_START;
+            }
+            else if (msg.command == CMD_TERMINATE) // TERMINATE komutu
+            {
+                int exited = (kill(msg.target_pid, 0) == -1 && errno == ESRCH && group_exited(msg.target_pid)); // Çıkış onaylandı mı?
+                int kill_result = 0;
+                int found = 0;
+                char leaf[64] = "";
+
+                shared_lock(h);
+                for (int i = 0; i < PROCX_MAX_PROCESSES; i++)  // Process listesinde ara
+                {
+                    if (shared_data->processes[i].pid == msg.target_pid) // Eşleşen process bulundu
+                    {
+                        begin_write(shared_data);
+                        if (exited)
+                        {
+                            if (shared_data->processes[i].is_active)
+                                strncpy(leaf, shared_data->processes[i].cgroup, sizeof(leaf));
+                            shared_data->processes[i].status = PROCX_TERMINATED;
+                            shared_data->processes[i].is_active = 0;
+                        }
+                        else if (shared_data->processes[i].is_active)
+                        {
+                            kill_result = request_termination(h, &shared_data->processes[i]); // Slot PROCX_RUNNING kalır
+                        }
+                        found = 1;
+                        break;
+                    }
+                }
+                int saved_errno = errno;
+                shared_unlock(h);
+                cgroup_release(leaf);
+
+                ev.type = PROCX_EVENT_REMOTE_TERMINATE;
+                if (kill_result == -1)
+                    ev.error = saved_errno;
+                else if (!exited) // SIGTERM gönderildi, watchdog gerekirse SIGKILL gönderecek
+                    ev.signal = SIGTERM;
+                else
+                    ev.exited = found;
+            }
+            else if (msg.command == CMD_TERMINATE_BATCH) // Toplu TERMINATE komutu
+            {
+                int count = msg.target_count;
+                if (count < 0 || count > PROCX_MAX_PROCESSES)
+                    count = 0;
+
+                // Tek kilitte tüm hedefleri işle; gönderen SIGTERM'i zaten yolladı
+                int exited_count = 0;
+                shared_lock(h);
+                for (int t = 0; t < count; t++)
+                {
+                    pid_t target = msg.targets[t];
+                    int exited = (kill(target, 0) == -1 && errno == ESRCH && group_exited(target));
+                    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+                    {
+                        if (shared_data->processes[i].pid != target || !shared_data->processes[i].is_active)
+                            continue;
+                        begin_write(shared_data);
+                        if (exited)
+                        {
+                            shared_data->processes[i].status = PROCX_TERMINATED;
+                            shared_data->processes[i].is_active = 0;
+                            cgroup_release(shared_data->processes[i].cgroup); // rmdir, kilit altında kısa sürer
+                            exited_count++;
+                        }
+                        else
+                        {
+                            request_termination(h, &shared_data->processes[i]); // Zaten gönderildiyse işlem yapmaz
+                        }
+                        break;
+                    }
+                }
+                shared_unlock(h);
+
+                ev.type = PROCX_EVENT_REMOTE_BATCH;
+                ev.count = count;
+                ev.exited_count = exited_count;
+            }
+            else
+            {
+                // Bilinmeyen komut
+                ev.type = PROCX_EVENT_UNKNOWN_COMMAND;
+                ev.command = msg.command;
+            }
+            emit_event(h, &ev);
+        }
+        else
+        {
+            if (errno == EIDRM || errno == EINVAL) { // Kuyruk kaldırıldıysa
+                 ProcessEvent ev = {.type = PROCX_EVENT_QUEUE_REMOVED};
+                 emit_event(h, &ev);
+                 break;
+            }
+        }
+    }
+    return NULL;
+}
+
+// --- AÇMA / KAPAMA ---
+
+procx_t *procx_open(const char *ns) // Kaynakları başlat
+{
+    procx_t *h = calloc(1, sizeof(*h));
+    if (h == NULL)
+        return NULL;
+
+    // Namespace, birbirinden yalıtılmış ProcX örnekleri için kaynak isimlerine eklenir
+    if (ns == NULL || *ns == '\0')
+    {
+        snprintf(h->shm_name, sizeof(h->shm_name), "%s", SHM_NAME);
+        snprintf(h->sem_name, sizeof(h->sem_name), "%s", SEM_NAME);
+        snprintf(h->mq_key_file, sizeof(h->mq_key_file), "%s", MQ_KEY_FILE);
+    }
+    else
+    {
+        snprintf(h->shm_name, sizeof(h->shm_name), "%s.%s", SHM_NAME, ns);
+        snprintf(h->sem_name, sizeof(h->sem_name), "%s.%s", SEM_NAME, ns);
+        snprintf(h->mq_key_file, sizeof(h->mq_key_file), "%s.%s", MQ_KEY_FILE, ns);
+    }
+    pthread_mutex_init(&h->sub_lock, NULL);
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+        h->pidfds[i] = -1;
+
+    FILE *fp = fopen(h->mq_key_file, "a"); // ftok için dosya oluştur
+    if (fp)
+        fclose(fp);
+    key_t key = ftok(h->mq_key_file, PROJ_ID); // Mesaj kuyruğu anahtarı oluştur
+    if (key == -1)
+        goto fail;
+
+    int shm_fd = shm_open(h->shm_name, O_CREAT | O_RDWR, 0666); // Paylaşılan bellek oluştur
+    if (shm_fd == -1)
+        goto fail;
+
+    if (ftruncate(shm_fd, sizeof(SharedData)) == -1) // Paylaşılan bellek boyutunu ayarla
+    {
+        close(shm_fd);
+        goto fail;
+    }
+
+    h->shared_data = mmap(0, sizeof(SharedData), PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0); // Paylaşılan bellek ram'e dahil edilir.
+    close(shm_fd); // Dosya tanıtıcısını kapat
+    if (h->shared_data == MAP_FAILED)
+    {
+        h->shared_data = NULL;
+        goto fail;
+    }
+
+    h->msqid = msgget(key, 0666 | IPC_CREAT); // Mesaj kuyruğu oluştur
+    if (h->msqid == -1)
+        goto fail;
+
+    h->sem = sem_open(h->sem_name, O_CREAT, 0644, 1); // Semaphore oluştur (sadece mutex'in ilk kurulumunu korur)
+    if (h->sem == SEM_FAILED)
+    {
+        h->sem = NULL;
+        goto fail;
+    }
+
+    while (sem_wait(h->sem) == -1 && errno == EINTR)
+        ;
+    if (!h->shared_data->lock_ready) // İlk terminal paylaşılan robust mutex'i kurar
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&h->shared_data->lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+        h->shared_data->lock_ready = 1;
+    }
+    sem_post(h->sem);
+
+    shared_lock(h); // Tabloyu kilitle
+    SharedData *shared_data = h->shared_data;
+    begin_write(shared_data); // Terminal kaydı
+    if (shared_data->terminal_count < 0 || shared_data->terminal_count > PROCX_MAX_TERMINALS) {
+        shared_data->terminal_count = 0; // Sayaçı başlat
+    }
+
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++) { // Fork sırasında ölen terminalin ayırdığı slotları serbest bırak
+        ProcessInfo *proc = &shared_data->processes[i];
+        if (proc->reserved && kill(proc->owner_pid, 0) == -1 && errno == ESRCH)
+            proc->reserved = 0;
+    }
+
+    int registered = 0;
+    for (int i = 0; i < PROCX_MAX_TERMINALS; i++) {
+        if (shared_data->active_terminals[i] == 0) {
+            shared_data->active_terminals[i] = getpid();
+            registered = 1;
+            break;
+        }
+    }
+    if (registered)
+        shared_data->terminal_count++;
+    shared_unlock(h); // Kilidi aç
+
+    if (!registered) { // Terminal listesi dolu
+        errno = EUSERS;
+        goto fail;
+    }
+
+    h->running = 1;
+    pthread_create(&h->monitor_tid, NULL, monitor_thread, h);           // İzleme iş parçacığını başlat
+    pthread_create(&h->watchdog_tid, NULL, watchdog_thread, h);         // Watchdog iş parçacığını başlat
+    pthread_create(&h->ipc_listener_tid, NULL, ipc_listener_thread, h); // IPC dinleyici iş parçacığını başlat
+    return h;
+
+fail:
+    {
+        int saved_errno = errno;
+        if (h->sem != NULL)
+            sem_close(h->sem);
+        if (h->shared_data != NULL)
+            munmap(h->shared_data, sizeof(SharedData));
+        pthread_mutex_destroy(&h->sub_lock);
+        free(h);
+        errno = saved_errno;
+        return NULL;
+    }
+}
+
+static void stop_threads(procx_t *h) // Thread'leri durdur
+{
+    h->running = 0; // Döngüyü durdur
+
+    broadcast_message(h, 0, 0); // IPC dinleyiciyi uyandır (ölü terminalleri ve mesajlarını da temizler)
+
+    Message wake_msg; // İzleme ve IPC iş parçacıklarını uyandırmak için mesaj gönder (Poison pill)
+    memset(&wake_msg, 0, sizeof(wake_msg));
+    wake_msg.msg_type = getpid(); // Alıcı: Benim kendi thread'im
+    wake_msg.command = 0;         // Özel çıkış komutu
+    wake_msg.sender_pid = getpid();
+    // Kuyruk başka terminallerin bildirimleriyle doluysa yer açılana kadar tekrar dene
+    while (msgsnd(h->msqid, &wake_msg, message_size(&wake_msg), IPC_NOWAIT) == -1 && errno == EAGAIN)
+        usleep(10000);
+
+    pthread_join(h->monitor_tid, NULL);      // İzleme iş parçacığını bekle
+    pthread_join(h->watchdog_tid, NULL);     // Watchdog iş parçacığını bekle
+    pthread_join(h->ipc_listener_tid, NULL); // IPC dinleyici iş parçacığını bekle
+}
+
+int procx_close(procx_t *h) // Kaynakları temizle
+{
+    SharedData *shared_data = h->shared_data;
+
+    stop_threads(h);
+
+    // Önce attached processleri kilit dışında sonlandır (grace period boyunca kilit tutulmaz)
+    pid_t attached[PROCX_MAX_PROCESSES];
+    int attached_count = 0;
+    shared_lock(h);
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        if (shared_data->processes[i].is_active &&
+            shared_data->processes[i].mode == PROCX_ATTACHED &&
+            shared_data->processes[i].owner_pid == getpid())
+        {
+            attached[attached_count++] = shared_data->processes[i].pid;
+        }
+    }
+    shared_unlock(h);
+    terminate_and_reap(h, attached, attached_count);
+    if (h->fg_job != 0) // Beklemesi yarıda kesilen attached iş terminalin ön planında kalmasın
+        restore_foreground(h);
+
+    shared_lock(h);
+    begin_write(shared_data);
+    // Terminal sayacını azalt
+    shared_data->terminal_count--;
+    int current_count = shared_data->terminal_count;
+
+    for (int i = 0; i < PROCX_MAX_TERMINALS; i++) {
+        if (shared_data->active_terminals[i] == getpid()) {
+            shared_data->active_terminals[i] = 0;
+            break;
+        }
+    }
+
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        if (shared_data->processes[i].is_active &&
+            shared_data->processes[i].mode == PROCX_ATTACHED &&
+            shared_data->processes[i].owner_pid == getpid())
+        {
+            shared_data->processes[i].is_active = 0; // Çıkış terminate_and_reap ile onaylandı
+            cgroup_release(shared_data->processes[i].cgroup);
+            shared_data->processes[i].status = PROCX_TERMINATED;
+        }
+    }
+
+    if (current_count <= 0) {
+        current_count = 0;
+        cgroup_sweep(); // Sahibinden uzun yaşamış detached işlerin yaprakları
+        shm_unlink(h->shm_name); // Paylaşılan belleği kaldır
+        msgctl(h->msqid, IPC_RMID, NULL); // Mesaj kuyruğunu kaldır
+        shared_unlock(h);        // Kilidi aç
+        sem_unlink(h->sem_name); // Semaphore'u kaldır
+    } else {
+        shared_unlock(h); // Kilidi aç
+    }
+
+    sem_close(h->sem);
+    munmap(shared_data, sizeof(SharedData)); // Paylaşılan belleği eşleştirmeyi kaldır
+
+    while (h->subs != NULL) // Kapatılmamış abonelikler
+    {
+        procx_sub_t *next = h->subs->next;
+        free_subscription(h->subs);
+        h->subs = next;
+    }
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++) // Yaşamaya devam eden detached işlerin pidfd'leri
+        if (h->pidfds[i] >= 0)
+            close(h->pidfds[i]);
+    pthread_mutex_destroy(&h->sub_lock);
+    free(h);
+    return current_count;
+}
+
+// --- PROCESS YÖNETİMİ ---
+
+// fork; cgroup verildiyse clone3(CLONE_INTO_CGROUP) ile doğrudan cgroup içinde başlat.
+// *placed hem parent hem child'da process'in cgroup'a girip girmediğini bildirir
+static pid_t spawn_process(int cgroup_fd, int *pidfd, int *placed)
+{
+    *pidfd = -1;
+    *placed = 0;
+#ifdef SYS_clone3
+    if (cgroup_fd >= 0)
+    {
+        struct clone_args args;
+        memset(&args, 0, sizeof(args));
+        args.flags = CLONE_INTO_CGROUP | CLONE_PIDFD; // pidfd child ile aynı anda oluşur
+        args.pidfd = (unsigned long)pidfd;
+        args.exit_signal = SIGCHLD;
+        args.cgroup = cgroup_fd;
+
+        pid_t pid = syscall(SYS_clone3, &args, sizeof(args));
+        if (pid != -1)
+        {
+            *placed = 1;
+            return pid;
+        }
+        // Eski çekirdek (ENOSYS/E2BIG) veya yapılamayan taşıma (EACCES/EPERM/EBUSY/EOPNOTSUPP): fork ile dene
+        *pidfd = -1;
+    }
+#endif
+    int verdict[2] = {-1, -1}; // Child cgroup'a girip giremediğini parent'a bildirir
+    if (cgroup_fd >= 0)
+    {
+        if (pipe(verdict) == -1)
+            cgroup_fd = -1;
+        else
+        {
+            fcntl(verdict[0], F_SETFD, FD_CLOEXEC); // Diğer işlerin child'larına sızmasın
+            fcntl(verdict[1], F_SETFD, FD_CLOEXEC);
+        }
+    }
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        if (cgroup_fd >= 0)
+        {
+            // Exec'ten önce kendini cgroup'a taşı (komut hiç dışarıda çalışmaz); olmazsa setrlimit'e düşülür
+            char ok = write_cgroup_file_at(cgroup_fd, "cgroup.procs", "0") == 0;
+            *placed = ok;
+            ssize_t res = write(verdict[1], &ok, 1);
+            (void)res;
+            close(verdict[0]);
+            close(verdict[1]);
+        }
+        return 0;
+    }
+    if (cgroup_fd >= 0)
+    {
+        char ok = 0;
+        close(verdict[1]);
+        if (pid > 0)
+        {
+            while (read(verdict[0], &ok, 1) == -1 && errno == EINTR)
+                ;
+        }
+        close(verdict[0]); // Child yazamadan öldüyse ok = 0
+        *placed = ok;
+    }
+#ifdef SYS_pidfd_open
+    // Child'ı sadece biz toplarız ve slotu henüz aktif değil: PID bu noktada yeniden kullanılamaz
+    if (pid > 0)
+        *pidfd = syscall(SYS_pidfd_open, pid, 0);
+#endif
+    return pid;
+}
+
+pid_t procx_spawn(procx_t *h, const ProcessSpec *spec) // Yeni process başlat
+{
+    SharedData *shared_data = h->shared_data;
+    char leaf[64] = "";
+    int cgroup_fd = -1;
+
+    if (spec->cgroup != NULL && !cgroup_spec_valid(spec->cgroup)) // Kök dışına mkdir/rmdir yapılmasın
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Fork'tan önce slot ayır: tablo doluysa hiç process başlatılmaz
+    shared_lock(h); // Tabloyu kilitle
+    int idx = -1;
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++) {
+        if (!shared_data->processes[i].is_active && !shared_data->processes[i].reserved) {
+            idx = i;
+            break;
+        }
+    }
+    if (idx != -1) {
+        begin_write(shared_data);
+        shared_data->processes[idx].reserved = 1;
+        shared_data->processes[idx].owner_pid = getpid();
+    }
+    shared_unlock(h); // Kilidi aç
+
+    if (idx == -1) { // Maksimum process sayısına ulaşıldı
+        errno = ENOSPC;
+        return -1;
+    }
+
+    if (spec->cgroup != NULL)
+    {
+        cgroup_fd = cgroup_prepare(h, spec->cgroup, leaf, sizeof(leaf));
+        if (cgroup_fd == -1)
+            leaf[0] = '\0'; // cgroup v2 yazılamıyor, setrlimit'e düş
+    }
+
+    int pidfd, placed;
+    pid_t pid = spawn_process(cgroup_fd, &pidfd, &placed); // Yeni process oluştur
+    if (pid < 0)
+    {
+        int saved_errno = errno;
+        if (cgroup_fd >= 0)
+        {
+            close(cgroup_fd);
+            cgroup_release(leaf);
+        }
+        shared_lock(h);
+        begin_write(shared_data);
+        shared_data->processes[idx].reserved = 0; // Ayrılan slotu geri ver
+        shared_unlock(h);
+        errno = saved_errno;
+        return -1;
+    }
+    else if (pid == 0)
+    { // Child process
+
+        if (spec->cgroup != NULL && !placed)
+            apply_rlimit_fallback(spec->cgroup);
+
+        if (spec->mode == PROCX_DETACHED)
+        {
+            if (setsid() < 0) // Terminal kapansa bile bu süreç arka planda çalışmaya devam eder (Daemonization)
+            { // Terminalden kopar
+                perror("setsid failed");
+                _exit(127);
+            }
+        }
+        else
+        {
+            pid_t terminal_pgrp = getpgrp();
+            setpgid(0, 0); // Kendi process grubu: sinyaller shell'in başlattığı komutlara da ulaşsın
+            if (isatty(STDIN_FILENO) && tcgetpgrp(STDIN_FILENO) == terminal_pgrp)
+            {
+                // Terminal ön planını devral (Ctrl+C ve klavye girişi attached işe gitsin)
+                sigset_t block, old;
+                sigemptyset(&block);
+                sigaddset(&block, SIGTTOU);
+                sigprocmask(SIG_BLOCK, &block, &old);
+                tcsetpgrp(STDIN_FILENO, getpid());
+                sigprocmask(SIG_SETMASK, &old, NULL);
+            }
+        }
+
+        char command_copy[256]; // Komutun kopyası
+        strncpy(command_copy, spec->command, 255); // Komutun bir kopyasını al
+        command_copy[255] = '\0'; // Null terminator ekle
+
+        char *args[] = {"/bin/sh", "-c", command_copy, NULL}; // Argüman dizisi
+        execvp(args[0], args); // Mevcut ProcX kodunu çocuk süreçten siler ve yerine kullanıcının istediği komutu yükler
+
+        perror("Exec failed");
+        _exit(127); // exit() gömen programın atexit işleyicilerini ve stdio tamponlarını çalıştırırdı
+    }
+
+    // Parent process
+    if (spec->mode == PROCX_ATTACHED)
+    {
+        setpgid(pid, pid); // Child'dan önce davranırsak da grup hazır olsun (PROCX_DETACHED kendi setsid'ini yapar)
+        if (isatty(STDIN_FILENO) && tcgetpgrp(STDIN_FILENO) == getpgrp())
+        {
+            tcsetpgrp(STDIN_FILENO, pid); // Ön plan procx_wait içinde geri alınır
+            h->fg_job = pid;
+        }
+    }
+    if (cgroup_fd >= 0)
+        close(cgroup_fd); // Child zaten cgroup içinde (veya setrlimit'e düştü)
+    if (!placed && leaf[0] != '\0') // cgroup'a girilemedi: yaprağı kaldır, tabloda cgroup gösterme
+    {
+        cgroup_release(leaf);
+        leaf[0] = '\0';
+    }
+
+    shared_lock(h); // Tabloyu kilitle
+    begin_write(shared_data);
+    if (h->pidfds[idx] >= 0) // Slotun önceki işinin pidfd'si
+        close(h->pidfds[idx]);
+    h->pidfds[idx] = pidfd; // Sinyaller PID yerine bu fd ile gönderilir
+    h->pidfd_pids[idx] = pid;
+    ProcessInfo *proc = &shared_data->processes[idx];
+    memset(proc, 0, sizeof(*proc));
+    proc->pid = pid;                                 // Process bilgilerini kaydet
+    proc->owner_pid = getpid();                      // Başlatan PID
+    strncpy(proc->command, spec->command, 255);      // Komut
+    proc->mode = spec->mode;                         // Mod
+    proc->status = PROCX_RUNNING;                    // Durum
+    proc->start_time = time(NULL);                   // Başlangıç zamanı
+    proc->limits = spec->limits;                     // Kaynak bütçesi
+    strncpy(proc->cgroup, leaf, sizeof(proc->cgroup) - 1); // cgroup yaprağı
+    proc->is_active = 1;                             // Aktif
+
+    shared_unlock(h); // Kilidi aç
+
+    broadcast_message(h, CMD_START, pid); // Başlatma mesajı gönder
+    return pid;
+}
+
+int procx_wait(procx_t *h, pid_t pid) // Attached modda bekle
+{
+    SharedData *shared_data = h->shared_data;
+    int status = 0;
+    char leaf[64] = "";
+
+    // Monitor önce topladıysa ECHILD döner, kayıt yine de güncellenir
+    if (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+        return -1; // Sinyal beklemeyi kesti, process hâlâ çalışıyor olabilir
+
+    if (h->fg_job == pid)
+        restore_foreground(h);
+
+    // Shell'in arka plana attığı komutlar grupta yaşıyorsa slot PROCX_RUNNING kalır, çıkışı monitor onaylar
+    if (!group_exited(pid))
+        return status;
+
+    shared_lock(h); // Tabloyu kilitle
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        if (shared_data->processes[i].pid == pid && shared_data->processes[i].is_active)
+        {
+            begin_write(shared_data);
+            shared_data->processes[i].status = PROCX_TERMINATED;
+            shared_data->processes[i].is_active = 0;
+            strncpy(leaf, shared_data->processes[i].cgroup, sizeof(leaf));
+            break;
+        }
+    }
+    shared_unlock(h); // Kilidi aç
+    cgroup_release(leaf);
+    broadcast_message(h, CMD_TERMINATE, pid); // Terminate mesajı gönder
+    return status;
+}
+
+static int selector_matches(const ProcessSelector *sel, const ProcessInfo *proc, time_t now) // Seçici process ile eşleşiyor mu?
+{
+    switch (sel->type)
+    {
+    case PROCX_SELECT_ALL:
+        return 1;
+    case PROCX_SELECT_OWNER:
+        return proc->owner_pid == sel->owner_pid;
+    case PROCX_SELECT_COMMAND:
+        return fnmatch(sel->pattern, proc->command, 0) == 0;
+    case PROCX_SELECT_MODE:
+        return proc->mode == sel->mode;
+    case PROCX_SELECT_AGE:
+        return difftime(now, proc->start_time) >= sel->min_age_sec;
+    case PROCX_SELECT_PID:
+        return proc->pid == sel->pid;
+    }
+    return 0;
+}
+
+int procx_kill(procx_t *h, const ProcessSelector *sel, pid_t *pids) // Seçiciyle eşleşenleri tek kilitte sonlandır
+{
+    int count = 0;
+    int failed_errno = 0;
+    time_t now = time(NULL);
+
+    shared_lock(h); // Çözümleme ve sinyalleme tek kilit altında
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        ProcessInfo *proc = &h->shared_data->processes[i];
+        if (!proc->is_active || !selector_matches(sel, proc, now))
+            continue;
+
+        begin_write(h->shared_data);
+        if (request_termination(h, proc) == 0) // Slot çıkış onaylanana kadar PROCX_RUNNING kalır
+            pids[count++] = proc->pid;
+        else
+            failed_errno = errno;
+    }
+    shared_unlock(h);
+
+    if (count > 0)
+        broadcast_batch(h, CMD_TERMINATE_BATCH, pids, count); // Tek birleşik bildirim
+
+    if (count == 0 && failed_errno != 0) // Eşleşenlerin hiçbiri sinyallenemedi
+    {
+        errno = failed_errno;
+        return -1;
+    }
+    return count;
+}
+
+int procx_find(procx_t *h, pid_t pid, ProcessInfo *out) // PID'e ait kaydı kopyala
+{
+    int found = -1;
+
+    shared_lock(h);
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        if (h->shared_data->processes[i].pid == pid && h->shared_data->processes[i].is_active)
+        {
+            *out = h->shared_data->processes[i];
+            found = 0;
+            break;
+        }
+    }
+    shared_unlock(h);
+    return found;
+}
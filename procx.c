@@ -3,510 +3,158 @@
 #include <stdio.h>     // printf, perror
 #include <stdlib.h>    // exit, atoi
 #include <string.h>    // memset, strncpy, strtok
-#include <unistd.h>    // fork, execvp, sleep
-#include <fcntl.h>     // O_CREAT, O_EXCL, O_RDWR
-#include <sys/mman.h>  // shm_open, mmap, shm_unlink, munmap
-#include <sys/stat.h>  // 0666
-#include <semaphore.h> // sem_open, sem_wait, sem_post, sem_close, sem_unlink
-#include <sys/msg.h>   // msgget, msgsnd, msgrcv
-#include <sys/types.h> // pid_t, key_t
+#include <unistd.h>    // getpid
+#include <sys/types.h> // pid_t
 #include <errno.h>     // error handling
 #include <time.h>      // time
-#include <signal.h>    // kill, SIGTERM
+#include <signal.h>    // sigaction, SIGINT
 #include <pthread.h>   // pthread_create, pthread_join
-#include <sys/wait.h>  // waitpid
 #include <ctype.h>     // isspace fonksiyonu için gerekli
-
-// --- ENUM VE SABITLER ---
-
-// Proje için gerekli dosya isimleri ve anahtarlar
-#define SHM_NAME "/procx_shm"      // Shared Memory Adı (POSIX standardı) [cite: 1925]
-#define SEM_NAME "/procx_sem"      // Semaphore Adı [cite: 1925]
-#define MQ_KEY_FILE "procx_mq_key" // Message Queue ftok dosyası (Lab 8 mantığı) [cite: 1116]
-#define PROJ_ID 65                 // ftok proje ID
-#define MAX_PROCESSES 50           // Maksimum process sayısı
-#define MAX_TERMINALS 100         // Maksimum terminal sayısı
-
-// ProcessMode Tanımı (Attached/Detached)
-typedef enum
-{
-    ATTACHED = 0,
-    DETACHED = 1
-} ProcessMode;
-
-// ProcessStatus Tanımı (Running/Terminated)
-typedef enum
-{
-    RUNNING = 0,
-    TERMINATED = 1
-} ProcessStatus;
-
-// Mesaj Komutları
-#define CMD_START 1
-#define CMD_TERMINATE 2
-// Process bilgisi
-typedef struct
-{
-    pid_t pid;            // Process ID
-    pid_t owner_pid;      // Başlatan instance'ın PID'si
-    char command[256];    // Çalıştırılan komut
-    ProcessMode mode;     // Attached (0) veya Detached (1)
-    ProcessStatus status; // Running (0) veya Terminated (1)
-    time_t start_time;    // Başlangıç zamanı
-    int is_active;        // Aktif mi? (1: Evet, 0: Hayır)
-} ProcessInfo;
-// Paylaşılan bellek yapısı
-typedef struct
-{
-    ProcessInfo processes[MAX_PROCESSES]; // Maksimum 50 process
-    int terminal_count; // Aktif terminal sayısını tutacak sayaç
-    pid_t active_terminals[MAX_TERMINALS]; // Aktif terminal PID'leri
-} SharedData;
-// Mesaj yapısı
-typedef struct
-{
-    long msg_type;    // Mesaj tipi
-    int command;      // Komut (START/TERMINATE)
-    pid_t sender_pid; // Gönderen PID
-    pid_t target_pid; // Hedef process PID
-} Message;
+#include "procx.h"        // libprocx API
 
 volatile sig_atomic_t interrupt_count = 0; // SIGINT kesme sayacı
 
 // Global değişkenler
-int shm_fd;                        // Shared Memory dosya tanıtıcısı
-SharedData *shared_data;           // Paylaşılan bellek işaretçisi
-sem_t *sem;                        // Semaphore işaretçisi
-int msqid;                         // Message Queue ID
-key_t key;                         // Message Queue anahtarı
+procx_t *px;                       // libprocx terminal tanıtıcısı
+procx_sub_t *events;               // Olay aboneliği
+pthread_t event_tid;               // Olay yazdırıcı iş parçacığı
 volatile sig_atomic_t running = 1; // Ana döngü kontrolü
 
-void broadcast_message(int command, pid_t target_pid) {
-    Message msg;
-    msg.command = command;
-    msg.sender_pid = getpid();
-    msg.target_pid = target_pid;
-
-    sem_wait(sem);
-    for (int i = 0; i < MAX_TERMINALS; i++) {
-        pid_t dest = shared_data->active_terminals[i];
-        // Sadece diğer aktif terminallere gönder
-        if (dest != 0 && dest != getpid()) {
-            msg.msg_type = dest; // Hedef PID
-            msgsnd(msqid, &msg, sizeof(Message) - sizeof(long), 0);
-        }
-    }
-    sem_post(sem);
-}
-
-void init_resources() // Kaynakları başlat
-{
-    FILE *fp = fopen("procx_mq_key", "a"); // ftok için dosya oluştur
-    if (fp)
-        fclose(fp);
-    key = ftok("procx_mq_key", 65); // Mesaj kuyruğu anahtarı oluştur
-
-    if (key == -1)
-    {
-        perror("ftok failed");
-        exit(1);
-    }
-
-    shm_fd = shm_open(SHM_NAME, O_CREAT | O_RDWR, 0666); // Paylaşılan bellek oluştur
-    if (shm_fd == -1)
-    {
-        perror("shm_open failed");
-        exit(1);
-    }
-
-    int res = ftruncate(shm_fd, sizeof(SharedData)); // Paylaşılan bellek boyutunu ayarla
-    if (res == -1)
-    {
-        perror("ftruncate failed");
-        exit(1);
-    }
-
-    shared_data = mmap(0, sizeof(SharedData), PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0); // Paylaşılan bellek ram'e dahil edilir.
-    if (shared_data == MAP_FAILED)
-    {
-        perror("mmap failed");
-        exit(1);
-    }
-
-    close(shm_fd); // Dosya tanıtıcısını kapat
-
-    msqid = msgget(key, 0666 | IPC_CREAT); // Mesaj kuyruğu oluştur
-    if (msqid == -1)
-    {
-        perror("msgget failed");
-        exit(1);
-    }
-
-    sem = sem_open(SEM_NAME, O_CREAT, 0644, 1); // Semaphore oluştur
-    if (sem == SEM_FAILED) // Hata kontrolü
-    {
-        perror("sem_open failed");
-        exit(1);
-    }
-    sem_wait(sem); // Semaphore kilitle
-    if (shared_data->terminal_count < 0 || shared_data->terminal_count > 100 ) {
-        shared_data->terminal_count = 0; // Sayaçı başlat
-    }
-    shared_data->terminal_count++;
-
-    int registered = 0;
-    for (int i = 0; i < MAX_TERMINALS; i++) {
-        if (shared_data->active_terminals[i] == 0) {
-            shared_data->active_terminals[i] = getpid();
-            registered = 1;
-            break;
-        }
-    }
-    if (!registered) {
-        printf("[Error] Terminal list is full!\n");
-        sem_post(sem);
-        exit(1);
-    }
-    printf("[Init] Terminal registered. Total terminals: %d\n", shared_data->terminal_count);
-    sem_post(sem); // Semaphore aç
-}
-
-void cleanup_resources() // Kaynakları temizle
-{
-    if (sem != NULL && sem != SEM_FAILED)
-    {
-        sem_wait(sem);
-        shared_data->terminal_count--;
-        int current_count = shared_data->terminal_count;
-
-        for (int i = 0; i < MAX_TERMINALS; i++) {
-        if (shared_data->active_terminals[i] == getpid()) {
-            shared_data->active_terminals[i] = 0;
-            break;
-        }
-    }
-
-        int is_last = (shared_data->terminal_count <= 0);
-
-        // Terminal sayacını azalt
-        for (int i = 0; i < MAX_PROCESSES; i++)
-        {
-            if (shared_data->processes[i].is_active &&
-                shared_data->processes[i].mode == ATTACHED &&
-                shared_data->processes[i].owner_pid == getpid())
-            {
-                kill(shared_data->processes[i].pid, SIGTERM); // Aktif processleri sonlandır
-
-                shared_data->processes[i].is_active = 0;
-                shared_data->processes[i].status = TERMINATED;
-            }
-        }
-        printf("[Cleanup] Terminated all attached processes started by this terminal.\n");
-
-        if(is_last) {
-        shm_unlink(SHM_NAME); // Paylaşılan belleği kaldır
-        msgctl(msqid, IPC_RMID, NULL); // Mesaj kuyruğunu kaldır
-        sem_post(sem);        // Semaphore aç
-        sem_unlink(SEM_NAME); // Semaphore'u kaldır
-        printf("[Cleanup] Last terminal exited. Resources fully cleaned up.\n");
-        }else{
-            sem_post(sem); // Semaphore aç
-            printf("[Cleanup] Terminal exited. Remaining terminals: %d\n", current_count);
-        }
-    }
-    munmap(shared_data, sizeof(SharedData)); // Paylaşılan belleği eşleştirmeyi kaldır
-}
+void shutdown_terminal(); // Thread'leri durdur, kaynakları bırak
 
 void sigint_handler(int signum)
-{ // SIGINT işleyici
+{ // SIGINT işleyici (sadece async-signal-safe çağrılar: write ve bayrak)
     (void)signum; // Unused parameter uyarısını bastır
+    static const char first[] = "\n[Handler] Caught SIGINT (1/3). Press Ctrl+C 2 more times to exit.\n";
+    static const char second[] = "\n[Handler] Caught SIGINT (2/3). Press Ctrl+C 1 more time to exit.\n";
+    static const char last[] = "\n[Handler] Caught SIGINT (3/3). Exiting now.\n";
+    ssize_t written;
     interrupt_count++;
 
     if (interrupt_count == 1)
     {
-        printf("\n[Handler] Caught SIGINT (1/3). Press Ctrl+C 2 more times to exit.\n");
+        written = write(STDOUT_FILENO, first, sizeof(first) - 1);
     }
     else if (interrupt_count == 2)
     {
-        printf("\n[Handler] Caught SIGINT (2/3). Press Ctrl+C 1 more time to exit.\n");
+        written = write(STDOUT_FILENO, second, sizeof(second) - 1);
     }
     else
     {
-        printf("\n[Handler] Caught SIGINT (3/3). Exiting now.\n");
-        cleanup_resources(); // Doğrudan kaynakları temizle
-        exit(0);             // Ve programdan hemen çık
+        written = write(STDOUT_FILENO, last, sizeof(last) - 1);
+        running = 0; // Kapanış ana döngüde yapılır (join ve kilitler sinyal bağlamında güvenli değil)
     }
+    (void)written;
 }
 
-void *monitor_thread(void *arg)
+void drain_input() // Satırın kalanını at (giriş kapandıysa veya okuma kesildiyse dur)
 {
-    (void)arg;
-    int status;
-
-    printf("\r\033[K[Monitor] Monitor thread started (PID: %d)\nSeçiminiz: ", getpid());
-    fflush(stdout);
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF)
+        ;
+}
 
-    while (running)
+void print_event(const ProcessEvent *ev) // Kütüphane olayını menü satırının üstüne yazdır
+{
+    switch (ev->type)
     {
-        sleep(2); // 2 saniye bekle
-        
-        // Dizideki tüm processleri kontrol et
-        for(int i = 0; i < MAX_PROCESSES; i++) { 
-            sem_wait(sem); // Semaphore kilitle
-            
-            // Sınır kontrolü ve aktiflik kontrolü
-            if(!shared_data->processes[i].is_active) {
-                sem_post(sem); // Hemen serbest bırak
-                continue;
-            }
-            
-            pid_t pid = shared_data->processes[i].pid;
-            pid_t owner_pid = shared_data->processes[i].owner_pid;
-            sem_post(sem); // Hemen serbest bırak
-            
-            int is_dead = 0;
-            
-            if (owner_pid == getpid()) {
-                // Kendi processimiz - waitpid ile kontrol et
-                if (waitpid(pid, &status, WNOHANG) == pid) {
-                    is_dead = 1;
-                }
-            } else {
-                // Başka instance'ın processi - kill(0) ile kontrol et
-                if (kill(pid, 0) == -1 && errno == ESRCH) { // Eğer bir süreç dışarıdan öldürülürse
-                    is_dead = 1;
-                }
-            }
-            
-            // Process öldüyse güncelle
-            if(is_dead) {
-                sem_wait(sem);
-                
-                // Process'i bul ve güncelle (PID ile ara çünkü index değişmiş olabilir)
-                int found = 0;
-                for(int j = 0; j < MAX_PROCESSES; j++) {
-                    if(shared_data->processes[j].pid == pid && 
-                       shared_data->processes[j].is_active) {
-                        shared_data->processes[j].status = TERMINATED;
-                        shared_data->processes[j].is_active = 0;
-                        found = 1;
-                        break;
-                    }
-                }
-                
-                sem_post(sem);
-                
-                if(found) {
-                    printf("\r\033[K[Monitor] Process %d terminated (Detected).\nSeçiminiz: ", pid);
-                    fflush(stdout);
-                    // Terminate mesajı gönder
-                    broadcast_message(CMD_TERMINATE, pid);
-                }
-            }
-        }
-        
-        // Zombie processleri topla
-        pid_t result;
-        while ((result = waitpid(-1, &status, WNOHANG)) > 0) { // Herhangi bir child process öldüyse zombi olarak kalmasını önler
-            sem_wait(sem);
-            
-            int found = 0;
-            for (int i = 0; i < MAX_PROCESSES; i++) {
-                if (shared_data->processes[i].pid == result && 
-                    shared_data->processes[i].is_active) {
-                    shared_data->processes[i].status = TERMINATED;
-                    shared_data->processes[i].is_active = 0;
-                    found = 1;
-                    break;
-                }
-            }
-            
-            sem_post(sem);
-            
-            if(found) {
-                printf("\r\033[K[Monitor] Process %d has terminated. Updated shared memory.\nSeçiminiz: ", result);
-                fflush(stdout);
-                
-                broadcast_message(CMD_TERMINATE, result);
-            }
-        }
+    case PROCX_EVENT_REMOTE_START:
+        printf("\r\033[K[IPC] Notification for PID %d\nSeçiminiz: ", ev->pid);
+        printf("\r\033[K[IPC] Process %d started by PID %d\nSeçiminiz: ", ev->pid, ev->sender_pid);
+        break;
+    case PROCX_EVENT_REMOTE_TERMINATE:
+        printf("\r\033[K[IPC] Notification for PID %d\nSeçiminiz: ", ev->pid);
+        printf("\r\033[K[IPC] Terminate request for PID %d from PID %d\nSeçiminiz: ", ev->pid, ev->sender_pid);
+        if (ev->error != 0)
+            printf("\r\033[K[IPC Listener] Failed to send termination signal: %s\nSeçiminiz: ", strerror(ev->error));
+        else if (ev->signal == SIGTERM) // Watchdog gerekirse SIGKILL gönderecek
+            printf("\r\033[K[IPC] SIGTERM sent to PID %d\nSeçiminiz: ", ev->pid);
+        else if (ev->exited)
+            printf("\r\033[K[IPC Listener] Process %d terminated via IPC.\nSeçiminiz: ", ev->pid);
+        break;
+    case PROCX_EVENT_REMOTE_BATCH:
+        printf("\r\033[K[IPC] Batch terminate of %d process(es) from PID %d (%d already exited)\nSeçiminiz: ",
+               ev->count, ev->sender_pid, ev->exited_count);
+        break;
+    case PROCX_EVENT_UNKNOWN_COMMAND:
+        printf("\r\033[K[IPC] Notification for PID %d\nSeçiminiz: ", ev->pid);
+        printf("\r\033[K[IPC Listener] Unknown command received: %d\nSeçiminiz: ", ev->command);
+        break;
+    case PROCX_EVENT_EXITED:
+        if (ev->reaped)
+            printf("\r\033[K[Monitor] Process %d has terminated. Updated shared memory.\nSeçiminiz: ", ev->pid);
+        else
+            printf("\r\033[K[Monitor] Process %d terminated (Detected).\nSeçiminiz: ", ev->pid);
+        break;
+    case PROCX_EVENT_WATCHDOG:
+        printf("\r\033[K[Watchdog] PID %d: %s, sent %s.\nSeçiminiz: ",
+               ev->pid, ev->reason, ev->signal == SIGKILL ? "SIGKILL" : "SIGTERM");
+        break;
+    case PROCX_EVENT_LOCK_RECOVERED:
+        if (ev->pid != 0)
+            printf("\r\033[K[Lock] Recovered lock held by dead PID %d\nSeçiminiz: ", ev->pid);
+        else
+            printf("\r\033[K[Lock] Recovered orphaned lock\nSeçiminiz: ");
+        break;
+    case PROCX_EVENT_QUEUE_REMOVED:
+        printf("\r\033[K[IPC Listener] Queue removed. Exiting.\n");
+        break;
     }
-    
-    return NULL;
+    fflush(stdout); // Ekrana hemen bas
 }
 
-void *ipc_listener_thread(void *arg) // IPC dinleyici iş parçacığı
-{ 
-    (void)arg; 
-    Message msg;
-
-    printf("\r\033[K[IPC Listener] IPC listener thread started (PID: %d)\nSeçiminiz: ", getpid());
-    fflush(stdout);
+void *event_thread(void *arg) // Olay yazdırıcı iş parçacığı
+{
+    (void)arg;
+    ProcessEvent ev;
 
-    while (running) // Ana döngü
+    while (running)
     {
-        if (msgrcv(msqid, &msg, sizeof(Message) - sizeof(long), getpid(), 0) != -1) // Mesaj alındıysa
-        {
-            if (errno == EINTR || !running) break; // Kapanış sinyali
-            // Kendi mesajımızı geri yansıtıyorsak (Hot Potato fix)
-            if (msg.sender_pid == getpid())
-            {
-                continue; 
-            }
-
-            printf("\r\033[K[IPC] Notification for PID %d\nSeçiminiz: ", msg.target_pid);
-            fflush(stdout);
-            // Mesaj türüne göre işlem yap
-            if (msg.command == CMD_START) // START komutu
-            {
-                printf("\r\033[K[IPC] Process %d started by PID %d\nSeçiminiz: ", msg.target_pid, msg.sender_pid);
-                fflush(stdout); // Ekrana hemen bas
-            }
-            // Mesaj türüne göre işlem yap
-            else if (msg.command == CMD_TERMINATE) // TERMINATE komutu
-            {
-                printf("\r\033[K[IPC] Terminate request for PID %d from PID %d\nSeçiminiz: ", msg.target_pid, msg.sender_pid);
-                fflush(stdout);
-
-                int kill_result = kill(msg.target_pid, SIGTERM); // SIGTERM gönder
-
-                if (kill_result == 0 || errno == ESRCH) // Başarılıysa veya process zaten yoksa
-                {
-                    if (kill_result == 0) // SIGTERM başarılıysa
-                    {
-                        printf("\r\033[K[IPC] SIGTERM sent to PID %d\nSeçiminiz: ", msg.target_pid);
-                        fflush(stdout);
-                    }
-
-                    sem_wait(sem); 
-                    int found = 0;
-                    for (int i = 0; i < MAX_PROCESSES; i++)  // Process listesinde ara
-                    {
-                        if (shared_data->processes[i].pid == msg.target_pid) // Eşleşen process bulundu
-                        {
-                            shared_data->processes[i].status = TERMINATED; 
-                            shared_data->processes[i].is_active = 0; 
-                            found = 1;
-                            break;
-                        }
-                    }
-                    sem_post(sem); 
-
-                    // "Terminated via IPC" mesajı
-                    if (found) {
-                        printf("\r\033[K[IPC Listener] Process %d terminated via IPC.\nSeçiminiz: ", msg.target_pid);
-                        fflush(stdout);
-                    }
-                }
-                else
-                {
-                    // Hata mesajı
-                    printf("\r\033[K");
-                    perror("[IPC Listener] Failed to send termination signal");
-                    printf("Seçiminiz: ");
-                    fflush(stdout);
-                }
-            }
-            else
-            {
-                // Bilinmeyen komut mesajı
-                printf("\r\033[K[IPC Listener] Unknown command received: %d\nSeçiminiz: ", msg.command);
-                fflush(stdout);
-            }
-        }
-        else
-        {
-            if (errno == EIDRM || errno == EINVAL) { // Kuyruk kaldırıldıysa
-                 printf("\r\033[K[IPC Listener] Queue removed. Exiting.\n");
-                 break;
-            }
-        }
+        if (procx_next_event(events, &ev, 200) == 1) // Kapanışı fark etmek için periyodik uyan
+            print_event(&ev);
     }
     return NULL;
 }
 
-void start_process(char *command, int mode) // Yeni process başlat
+void start_process(const char *command, int mode, const ResourceLimits *limits, const CgroupSpec *cgroup) // Yeni process başlat
 {
-    pid_t pid = fork(); // Yeni process oluştur
-    if (pid < 0)
+    ProcessSpec spec;
+    spec.command = command;
+    spec.mode = mode;
+    spec.limits = *limits;
+    spec.cgroup = cgroup;
+
+    pid_t pid = procx_spawn(px, &spec);
+    if (pid == -1)
     {
-        perror("Fork failed");
+        if (errno == ENOSPC)
+            printf("[Main] Maximum process limit reached. Cannot start new process.\n");
+        else if (errno == EINVAL)
+            printf("[ERROR] Invalid cgroup settings.\n");
+        else
+            perror("Fork failed");
         return;
     }
-    else if (pid == 0)
-    { // Child process
 
-        if (mode == DETACHED)
-        {
-            if (setsid() < 0) // Terminal kapansa bile bu süreç arka planda çalışmaya devam eder (Daemonization)
-            { // Terminalden kopar
-                perror("setsid failed");
-                exit(1);
-            }
-        }
-
-        char command_copy[256]; // Komutun kopyası
-        strncpy(command_copy, command, 255); // Komutun bir kopyasını al
-        command_copy[255] = '\0'; // Null terminator ekle
-
-        char *args[] = {"/bin/sh", "-c", command_copy, NULL}; // Argüman dizisi
-        execvp(args[0], args); // Mevcut ProcX kodunu çocuk süreçten siler ve yerine kullanıcının istediği komutu yükler
-
-        perror("Exec failed");
-        exit(1);
+    printf("[Main] Started process (PID: %d) in %s mode\n",
+           pid, mode == PROCX_ATTACHED ? "ATTACHED" : "DETACHED");
+    ProcessInfo info;
+    if (cgroup != NULL && procx_find(px, pid, &info) == 0) // Kısa süren process zaten çıkmış olabilir
+    {
+        if (info.cgroup[0] != '\0')
+            printf("[Main] Process %d placed in cgroup %s/%s\n", pid, procx_cgroup_root(), info.cgroup);
+        else
+            printf("[Main] cgroup v2 not writable under %s, fell back to setrlimit.\n", procx_cgroup_root());
     }
-    else
-    {                  // Parent process
-        sem_wait(sem); // Semaphore kilitle
-        int idx = -1;
-        for (int i = 0; i < MAX_PROCESSES; i++) {
-            if (!shared_data->processes[i].is_active) {
-                idx = i;
-                break;
-            }
-        }
-
-        if (idx == -1) {
-            printf("[Main] Maximum process limit reached. Cannot start new process.\n");
-            sem_post(sem); // Semaphore aç
-            kill(pid, SIGTERM); // Başarısızsa child'ı öldür
-            return;
-        }
-
-        shared_data->processes[idx].pid = pid;                      // Process bilgilerini kaydet
-        shared_data->processes[idx].owner_pid = getpid();           // Başlatan PID
-        strncpy(shared_data->processes[idx].command, command, 255); // Komut
-        shared_data->processes[idx].mode = mode;                    // Mod
-        shared_data->processes[idx].status = RUNNING;               // Durum
-        shared_data->processes[idx].start_time = time(NULL);        // Başlangıç zamanı
-        shared_data->processes[idx].is_active = 1;                  // Aktif
-
-        sem_post(sem); // Semaphore aç
-        printf("[Main] Started process (PID: %d) in %s mode\n",
-               pid, mode == ATTACHED ? "ATTACHED" : "DETACHED");
 
-        broadcast_message(CMD_START, pid); // Başlatma mesajı gönder
-
-        if (mode == ATTACHED)
+    if (mode == PROCX_ATTACHED)
+    {
+        while (procx_wait(px, pid) == -1 && errno == EINTR) // Attached modda bekle
         {
-            int status;
-            waitpid(pid, &status, 0); // Attached modda bekle
-
-            printf("[Main] Attached process (PID: %d) has terminated.\n", pid);
-
-            sem_wait(sem); // Semaphore kilitle
-            for (int i = 0; i < MAX_PROCESSES; i++)
-            {
-                if (shared_data->processes[i].pid == pid)
-                {
-                    shared_data->processes[i].status = TERMINATED;
-                    shared_data->processes[i].is_active = 0;
-                    break;
-                }
-            }
-            sem_post(sem); // Semaphore aç
-            broadcast_message(CMD_TERMINATE, pid); // Terminate mesajı gönder
+            if (!running) // Kapanış istendi, iş procx_close ile sonlandırılır
+                return;
         }
+        printf("[Main] Attached process (PID: %d) has terminated.\n", pid);
     }
 }
 
@@ -538,6 +186,7 @@ void display_menu() // Menü göster
     printf("║ 1. Yeni Program Çalıştır           ║\n");
     printf("║ 2. Çalışan Programları Listele     ║\n");
     printf("║ 3. Program Sonlandır               ║\n");
+    printf("║ 4. Toplu Sonlandır                 ║\n");
     printf("║ 0. Çıkış                           ║\n");
     printf("╚════════════════════════════════════╝\n");
     printf("Seçiminiz: ");
@@ -549,8 +198,9 @@ void handle_start_process() // Yeni program başlat
     int mode;
 
     printf("Enter command to execute: ");
-    fgets(command, sizeof(command), stdin);
-    
+    if (fgets(command, sizeof(command), stdin) == NULL)
+        return;
+
     trim(command); // Baş ve sondaki boşlukları kaldır
 
     command[strcspn(command, "\n")] = 0; // Newline kaldır
@@ -558,11 +208,11 @@ void handle_start_process() // Yeni program başlat
     printf("Mode (0=ATTACHED, 1=DETACHED): ");
     if(scanf("%d", &mode) != 1){ // Geçersiz giriş kontrolü
         printf("Wrong input! Please enter 0 or 1.\n");
-        while(getchar() != '\n'); // Tamponu temizle
+        drain_input(); // Tamponu temizle
         return;
     }
 
-    while (getchar() != '\n'); // Tamponu temizle
+    drain_input(); // Tamponu temizle
 
     if (mode != 0 && mode != 1)
     {
@@ -570,40 +220,101 @@ void handle_start_process() // Yeni program başlat
         return;
     }
 
-    start_process(command, mode);
+    ResourceLimits limits = {0, 0, 0};
+    long rss_mb = 0;
+    char line[128];
+    printf("Limits: wall(s) cpu(s) rss(MB) (0=unlimited, Enter=none): ");
+    if (fgets(line, sizeof(line), stdin) != NULL)
+    {
+        trim(line);
+        if (line[0] != '\0' &&
+            (sscanf(line, "%ld %ld %ld", &limits.wall_sec, &limits.cpu_sec, &rss_mb) < 1 ||
+             limits.wall_sec < 0 || limits.cpu_sec < 0 || rss_mb < 0))
+        {
+            printf("[ERROR] Invalid limits. Use non-negative numbers.\n");
+            return;
+        }
+    }
+    limits.rss_kb = rss_mb * 1024;
+
+    CgroupSpec cgroup = {"", 0, 0, 0};
+    int use_cgroup = 0;
+    printf("Cgroup: group(tag|- per process) cpu(%%) mem(MB) io_weight (Enter=none): ");
+    if (fgets(line, sizeof(line), stdin) != NULL)
+    {
+        trim(line);
+        if (line[0] != '\0')
+        {
+            char group[64];
+            int n = sscanf(line, "%63s %ld %ld %d", group, &cgroup.cpu_percent, &cgroup.memory_mb, &cgroup.io_weight);
+            if (n < 1) // Etiket ve değerler procx_spawn içinde doğrulanır
+            {
+                printf("[ERROR] Invalid cgroup settings.\n");
+                return;
+            }
+            if (strcmp(group, "-") != 0)
+                strcpy(cgroup.group, group);
+            use_cgroup = 1;
+        }
+    }
+
+    start_process(command, mode, &limits, use_cgroup ? &cgroup : NULL);
 }
 
 void handle_list_process() // Çalışan programları listele
 {
+    char rows[PROCX_MAX_PROCESSES][192];
+    char pressure[PROCX_MAX_PROCESSES][128];
+    int row_count, pressure_count;
+    ProcessSnapshot snap;
+
     printf("Listing running programs...\n");
-    sem_wait(sem);
+    do // Tablo kilitlenmeden doğrudan paylaşılan bellekten okunur
+    {
+        row_count = pressure_count = 0;
+        time_t now = time(NULL);
+        const ProcessInfo *proc;
+
+        procx_snapshot_begin(px, &snap);
+        while ((proc = procx_snapshot_next(&snap)) != NULL)
+        {
+            double duration = difftime(now, proc->start_time);
+
+            char *status_str = (proc->status != PROCX_RUNNING) ? "Terminate"
+                             : (proc->term_sent_time != 0) ? "Stopping" : "Running";
+            char *mode_str = (proc->mode == PROCX_ATTACHED) ? "Attached" : "Detached";
+
+            snprintf(rows[row_count++], sizeof(rows[0]), "║ %-3d ║ %-5d ║ %-17.17s ║ %-8s ║ %-9s ║ %-7d ║ %6.0f s ║\n",
+                     (int)(proc - snap.table->processes),
+                     proc->pid,
+                     proc->command,
+                     mode_str,
+                     status_str,
+                     proc->owner_pid,
+                     duration);
+
+            // cgroup içindeki processler için basınç (PSI some avg10) bilgisi
+            if (proc->cgroup[0] != '\0')
+            {
+                snprintf(pressure[pressure_count++], sizeof(pressure[0]), "  [cgroup] PID %-5d %-20.20s PSI cpu=%.2f mem=%.2f io=%.2f\n",
+                         proc->pid,
+                         proc->cgroup,
+                         proc->psi_cpu,
+                         proc->psi_memory,
+                         proc->psi_io);
+            }
+        }
+    } while (procx_snapshot_end(&snap) == -1); // Okuma sırasında tablo değişti, tekrar oku
+
     printf("\n");
     printf("╔═════╦═══════╦═══════════════════╦══════════╦═══════════╦═════════╦══════════╗\n");
     printf("║  #  ║  PID  ║     Command       ║   Mode   ║  Status   ║  Owner  ║   Time   ║\n");
     printf("╠═════╬═══════╬═══════════════════╬══════════╬═══════════╬═════════╬══════════╣\n");
-
-    for (int i = 0; i < MAX_PROCESSES; i++)
-    {
-        if (shared_data->processes[i].is_active)
-        {
-            time_t now = time(NULL);
-            double duration = difftime(now, shared_data->processes[i].start_time);
-
-            char *status_str = (shared_data->processes[i].status == RUNNING) ? "Running" : "Terminate";
-            char *mode_str = (shared_data->processes[i].mode == ATTACHED) ? "Attached" : "Detached";
-            
-            printf("║ %-3d ║ %-5d ║ %-17.17s ║ %-8s ║ %-9s ║ %-7d ║ %6.0f s ║\n",
-                   i,
-                   shared_data->processes[i].pid,
-                   shared_data->processes[i].command,
-                   mode_str,
-                   status_str,
-                   shared_data->processes[i].owner_pid,
-                   duration);
-        }
-    }
-    sem_post(sem);
+    for (int i = 0; i < row_count; i++)
+        fputs(rows[i], stdout);
     printf("╚═════╩═══════╩═══════════════════╩══════════╩═══════════╩═════════╩══════════╝\n");
+    for (int i = 0; i < pressure_count; i++)
+        fputs(pressure[i], stdout);
 }
 
 void handle_terminate_process() // Program sonlandır
@@ -613,55 +324,120 @@ void handle_terminate_process() // Program sonlandır
     if (scanf("%d", &target_pid) != 1) // Geçersiz giriş kontrolü
     {
         printf("[ERROR] Invalid PID format.\n");
-        while (getchar() != '\n');
+        drain_input();
         return;
     }
-    while (getchar() != '\n'); // Tamponu temizle
+    drain_input(); // Tamponu temizle
 
     // PID'nin yönetilen processler arasında olup olmadığını kontrol et
-    sem_wait(sem);
-    int found = 0;
-    for (int i = 0; i < MAX_PROCESSES; i++)
-    {
-        if (shared_data->processes[i].pid == target_pid && 
-            shared_data->processes[i].is_active)
-        {
-            found = 1;
-            break;
-        }
-    }
-    sem_post(sem);
-
-    if (!found)
+    ProcessInfo info;
+    if (procx_find(px, target_pid, &info) == -1)
     {
         printf("[ERROR] PID %d not found in managed processes.\n", target_pid);
         return;
     }
 
     // PID doğrulandı, şimdi sonlandır
-    if (kill(target_pid, SIGTERM) == 0)
+    ProcessSelector sel;
+    pid_t pids[PROCX_MAX_PROCESSES];
+    memset(&sel, 0, sizeof(sel));
+    sel.type = PROCX_SELECT_PID;
+    sel.pid = target_pid;
+
+    int count = procx_kill(px, &sel, pids);
+    if (count > 0)
     {
         printf("Sent termination signal to PID %d\n", target_pid);
-        sem_wait(sem); // Semaphore kilitle
-        for (int i = 0; i < MAX_PROCESSES; i++) // Paylaşılan bellekte ara
-        {
-            if (shared_data->processes[i].pid == target_pid && 
-                shared_data->processes[i].is_active)
-            {
-                shared_data->processes[i].status = TERMINATED; // Durumu güncelle
-                shared_data->processes[i].is_active = 0;       // Aktif değil olarak işaretle
-                printf("Process %d marked as terminated in shared memory.\n", target_pid);
-                break;
-            }
-        }
-        sem_post(sem); // Semaphore aç
+        printf("Process %d will be marked as terminated once its exit is confirmed (SIGKILL after %d s).\n",
+               target_pid, PROCX_GRACE_PERIOD);
     }
     else
     {
+        if (count == 0) // Kontrol ile sinyal arasında çıktı
+            errno = ESRCH;
         perror("Failed to send termination signal");
     }
 }
 
+int parse_selector(char *input, ProcessSelector *sel) // "all | owner [pid] | cmd <glob> | mode <0|1> | age <sn>"
+{
+    char *arg = input + strcspn(input, " \t");
+    if (*arg != '\0')
+    {
+        *arg++ = '\0';
+        trim(arg);
+    }
+
+    memset(sel, 0, sizeof(*sel));
+    if (strcmp(input, "all") == 0)
+    {
+        sel->type = PROCX_SELECT_ALL;
+        return 0;
+    }
+    if (strcmp(input, "owner") == 0)
+    {
+        sel->type = PROCX_SELECT_OWNER;
+        sel->owner_pid = (*arg == '\0') ? getpid() : atoi(arg); // Parametresiz: bu terminal
+        return sel->owner_pid > 0 ? 0 : -1;
+    }
+    if (strcmp(input, "cmd") == 0 && *arg != '\0')
+    {
+        sel->type = PROCX_SELECT_COMMAND;
+        strncpy(sel->pattern, arg, sizeof(sel->pattern) - 1);
+        return 0;
+    }
+    if (strcmp(input, "mode") == 0 && (strcmp(arg, "0") == 0 || strcmp(arg, "1") == 0))
+    {
+        sel->type = PROCX_SELECT_MODE;
+        sel->mode = atoi(arg);
+        return 0;
+    }
+    if (strcmp(input, "age") == 0 && *arg != '\0')
+    {
+        char *end;
+        sel->type = PROCX_SELECT_AGE;
+        sel->min_age_sec = strtol(arg, &end, 10);
+        return (*end == '\0' && sel->min_age_sec >= 0) ? 0 : -1;
+    }
+    return -1;
+}
+
+void handle_bulk_terminate() // Seçiciye göre toplu sonlandır
+{
+    char input[300];
+    ProcessSelector sel;
+    pid_t pids[PROCX_MAX_PROCESSES];
+
+    printf("Selector (all | owner [pid] | cmd <glob> | mode <0|1> | age <sec>): ");
+    if (fgets(input, sizeof(input), stdin) == NULL)
+        return;
+    trim(input);
+
+    if (parse_selector(input, &sel) == -1)
+    {
+        printf("[ERROR] Invalid selector.\n");
+        return;
+    }
+
+    int count = procx_kill(px, &sel, pids);
+    if (count == -1)
+    {
+        perror("Failed to send termination signal");
+        return;
+    }
+    if (count == 0)
+    {
+        printf("[ERROR] No managed process matched the selector.\n");
+        return;
+    }
+
+    printf("Sent termination signal to %d process(es):", count);
+    for (int i = 0; i < count; i++)
+        printf(" %d", pids[i]);
+    printf("\nProcesses will be marked as terminated once their exit is confirmed (SIGKILL after %d s).\n",
+           PROCX_GRACE_PERIOD);
+}
+
 void setup_signal_handlers() // Sinyal işleyicilerini ayarla
 {
     struct sigaction sa;
@@ -676,28 +452,52 @@ void setup_signal_handlers() // Sinyal işleyicilerini ayarla
     }
 }
 
-void start_threads(pthread_t *monitor_tid, pthread_t *ipc_listener_tid) // İş parçacıklarını başlat
+void shutdown_terminal() // Thread'leri durdur, kaynakları bırak
 {
-    pthread_create(monitor_tid, NULL, monitor_thread, NULL);           // İzleme iş parçacığını başlat
-    pthread_create(ipc_listener_tid, NULL, ipc_listener_thread, NULL); // IPC dinleyici iş parçacığını başlat
+    running = 0; // Döngüyü durdur
+    pthread_join(event_tid, NULL); // Olay yazdırıcıyı bekle
+    procx_unsubscribe(events);
+
+    int remaining = procx_close(px); // Kütüphane thread'lerini durdurur ve attached processleri sonlandırır
+    printf("[Cleanup] Terminated all attached processes started by this terminal.\n");
+    if (remaining == 0)
+        printf("[Cleanup] Last terminal exited. Resources fully cleaned up.\n");
+    else
+        printf("[Cleanup] Terminal exited. Remaining terminals: %d\n", remaining);
 }
 
 int main() // Ana fonksiyon
 {
-
-    pthread_t monitor_tid, ipc_listener_tid;
     int choice;
 
     setup_signal_handlers(); // Sinyal işleyicilerini ayarla
 
-    init_resources(); // Kaynakları başlat
+    // SIGINT sadece ana thread'de işlensin (işleyici kütüphane thread'lerini join eder)
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &block, &old);
+
+    px = procx_open(getenv("PROCX_NS")); // Kaynakları başlat (PROCX_NS: yalıtılmış örnekler için isteğe bağlı namespace)
+    if (px == NULL)
+    {
+        if (errno == EUSERS)
+            printf("[Error] Terminal list is full!\n");
+        else
+            perror("procx_open failed");
+        exit(1);
+    }
+    events = procx_subscribe(px);
+    pthread_create(&event_tid, NULL, event_thread, NULL); // Olay yazdırıcıyı başlat
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    procx_lock(px);
+    printf("[Init] Terminal registered. Total terminals: %d\n", procx_table(px)->terminal_count);
+    procx_unlock(px);
 
     printf("[Main] Process started (PID: %d). Waiting for signals...\n", getpid());
     printf("[Main] Press Ctrl+C to trigger the handler.\n");
 
-    start_threads(&monitor_tid, &ipc_listener_tid); // İş parçacıklarını başlat
-    usleep(100000); // İş parçacıklarının başlaması için kısa bir gecikme
-
     printf("\nWelcome to ProcX - Process Management System\n");
 
     while (running)
@@ -705,12 +505,18 @@ int main() // Ana fonksiyon
         display_menu(); // Menü göster
 
         if(scanf("%d", &choice) != 1){ // Kullanıcıdan seçim al
-            while (getchar() != '\n'); // Giriş tamponunu temizle
+            if (!running || feof(stdin)) // Ctrl+C ile kapanış istendi ya da giriş kapandı
+                break;
+            if (ferror(stdin)) { // Ctrl+C okumayı kesti, menüyü tekrar göster
+                clearerr(stdin);
+                continue;
+            }
+            drain_input(); // Giriş tamponunu temizle
             printf("Wrong input! Please enter a number.\n");
             continue;
         }
 
-        while (getchar() != '\n'); // Giriş tamponunu temizle
+        drain_input(); // Giriş tamponunu temizle
 
         switch (choice) // Seçime göre işlem yap
         {
@@ -727,28 +533,19 @@ int main() // Ana fonksiyon
             handle_terminate_process(); // Process sonlandır
             break;
         }
+        case 4:
+            handle_bulk_terminate(); // Seçiciye göre toplu sonlandır
+            break;
         case 0:
             printf("[Main] Exiting ProcX...\n");
-            running = 0; // Döngüyü durdur
-
-            Message wake_msg; // İzleme ve IPC iş parçacıklarını uyandırmak için mesaj gönder (Poison pill)
-            wake_msg.msg_type = getpid(); // Alıcı: Benim kendi thread'im
-            wake_msg.command = 0;         // Özel çıkış komutu
-            wake_msg.sender_pid = getpid();
-            msgsnd(msqid, &wake_msg, sizeof(Message) - sizeof(long), IPC_NOWAIT);
-
-            broadcast_message(0, 0); // IPC dinleyiciyi uyandır
-
-            pthread_join(monitor_tid, NULL);      // İzleme iş parçacığını bekle
-            pthread_join(ipc_listener_tid, NULL); // IPC dinleyici iş parçacığını bekle
-
-            cleanup_resources(); // Kaynakları temizle
-            printf("Exiting ProcX. Goodbye!\n");
-            exit(0);
+            running = 0; // Döngüden çık, kapanış aşağıda
             break;
         default:
             printf("Invalid choice. Please try again.\n");
         }
     }
+
+    shutdown_terminal(); // Thread'leri durdur ve kaynakları temizle (Ctrl+C dahil tüm çıkışlar buradan)
+    printf("Exiting ProcX. Goodbye!\n");
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,201 @@
+#ifndef PROCX_H
+#define PROCX_H
+
+// libprocx - ProcX çekirdeğinin gömülebilir C API'si
+//
+// Tüm terminaller aynı paylaşılan bellek tablosunu (SharedData) kullanır. procx_open()
+// terminali kaydeder ve izleme, watchdog ve IPC dinleyici thread'lerini başlatır.
+// Tablo kopyalanmadan okunabilir: procx_snapshot_* işaretçileri doğrudan paylaşılan
+// belleğe verir, tutarlılık seqlock ile doğrulanır.
+//
+// Kütüphane sadece procx_spawn ile başlattığı PID'leri waitpid ile toplar; gömen programın
+// kendi çocuklarına dokunmaz. Dışa açılan tüm sabitler PROCX_ önekini taşır.
+
+#include <sys/types.h> // pid_t
+#include <pthread.h>   // pthread_mutex_t
+#include <time.h>      // time_t
+
+// --- SABITLER ---
+
+#define PROCX_MAX_PROCESSES 50   // Maksimum process sayısı
+#define PROCX_MAX_TERMINALS 100  // Maksimum terminal sayısı
+#define PROCX_GRACE_PERIOD 5     // SIGTERM sonrası SIGKILL'e kadar beklenecek süre (saniye)
+
+// ProcessMode Tanımı (Attached/Detached)
+typedef enum
+{
+    PROCX_ATTACHED = 0,
+    PROCX_DETACHED = 1
+} ProcessMode;
+
+// ProcessStatus Tanımı (Running/Terminated)
+typedef enum
+{
+    PROCX_RUNNING = 0,
+    PROCX_TERMINATED = 1
+} ProcessStatus;
+
+// Kaynak bütçesi (0 = sınırsız)
+typedef struct
+{
+    long wall_sec; // Maksimum çalışma süresi (saniye)
+    long cpu_sec;  // Maksimum CPU süresi (saniye)
+    long rss_kb;   // Maksimum bellek kullanımı (KB)
+} ResourceLimits;
+
+// cgroup v2 izolasyon ayarları (0 = sınırsız)
+typedef struct
+{
+    char group[64];   // Grup etiketi ("" = süreç başına yaprak, "job-" öneki ayrılmış)
+    long cpu_percent; // cpu.max (100 = 1 çekirdek)
+    long memory_mb;   // memory.max
+    int io_weight;    // io.weight (1-10000)
+} CgroupSpec;
+
+// Process bilgisi
+typedef struct
+{
+    pid_t pid;             // Process ID
+    pid_t owner_pid;       // Başlatan instance'ın PID'si
+    char command[256];     // Çalıştırılan komut
+    ProcessMode mode;      // Attached (0) veya Detached (1)
+    ProcessStatus status;  // Running (0) veya Terminated (1)
+    time_t start_time;     // Başlangıç zamanı
+    int is_active;         // Aktif mi? (1: Evet, 0: Hayır)
+    ResourceLimits limits; // Watchdog tarafından uygulanan bütçe
+    time_t term_sent_time; // SIGTERM gönderilme zamanı (0: gönderilmedi)
+    int kill_sent;         // SIGKILL gönderildi mi? (1: Evet, 0: Hayır)
+    char cgroup[64];       // cgroup yaprak adı ("" = procx'in kendi cgroup'u)
+    double psi_cpu;        // cpu.pressure "some avg10"
+    double psi_memory;     // memory.pressure "some avg10"
+    double psi_io;         // io.pressure "some avg10"
+    int reserved;          // procx_spawn fork için ayırdı, henüz aktif değil (owner_pid sahibi)
+} ProcessInfo;
+
+// Paylaşılan bellek yapısı
+typedef struct
+{
+    ProcessInfo processes[PROCX_MAX_PROCESSES]; // Maksimum 50 process
+    int terminal_count; // Aktif terminal sayısını tutacak sayaç
+    pid_t active_terminals[PROCX_MAX_TERMINALS]; // Aktif terminal PID'leri
+    pthread_mutex_t lock; // Process'ler arası robust mutex (sahibi ölürse devralınır)
+    int lock_ready;     // Mutex kuruldu mu?
+    pid_t lock_owner;   // Kilidi tutan terminalin PID'si (0: serbest)
+    unsigned int seq;   // Seqlock sayacı (tek: yazma sürüyor)
+    unsigned int lock_recoveries;      // Ölü sahipten devralınan kilit sayısı
+    struct timespec lock_recovered_at; // Son devralma anı (CLOCK_MONOTONIC, sayaçtan önce yazılır)
+} SharedData;
+
+// Yeni process tanımı
+typedef struct
+{
+    const char *command;      // /bin/sh -c ile çalıştırılacak komut
+    ProcessMode mode;         // Attached veya Detached
+    ResourceLimits limits;    // Watchdog bütçesi
+    const CgroupSpec *cgroup; // NULL = procx'in kendi cgroup'u
+} ProcessSpec;
+
+// Sonlandırma seçici türleri
+typedef enum
+{
+    PROCX_SELECT_ALL = 0,     // Tüm aktif processler
+    PROCX_SELECT_OWNER = 1,   // Başlatan terminale göre
+    PROCX_SELECT_COMMAND = 2, // Komut glob desenine göre
+    PROCX_SELECT_MODE = 3,    // Attached/Detached moduna göre
+    PROCX_SELECT_AGE = 4,     // Minimum çalışma süresine göre
+    PROCX_SELECT_PID = 5      // Tek bir PID
+} SelectorType;
+
+// Sonlandırma seçicisi
+typedef struct
+{
+    SelectorType type;
+    pid_t owner_pid;   // PROCX_SELECT_OWNER
+    char pattern[256]; // PROCX_SELECT_COMMAND
+    ProcessMode mode;  // PROCX_SELECT_MODE
+    long min_age_sec;  // PROCX_SELECT_AGE
+    pid_t pid;         // PROCX_SELECT_PID
+} ProcessSelector;
+
+// Olay türleri
+typedef enum
+{
+    PROCX_EVENT_REMOTE_START = 1,   // Başka terminal process başlattı
+    PROCX_EVENT_REMOTE_TERMINATE,   // Başka terminalden sonlandırma bildirimi
+    PROCX_EVENT_REMOTE_BATCH,       // Başka terminalden toplu sonlandırma
+    PROCX_EVENT_UNKNOWN_COMMAND,    // Tanınmayan IPC komutu
+    PROCX_EVENT_EXITED,             // İzlenen process'in çıkışı onaylandı
+    PROCX_EVENT_WATCHDOG,           // Watchdog sinyal gönderdi
+    PROCX_EVENT_LOCK_RECOVERED,     // Ölü terminalin tuttuğu kilit devralındı
+    PROCX_EVENT_QUEUE_REMOVED       // Mesaj kuyruğu kaldırıldı
+} ProcessEventType;
+
+// Olay
+typedef struct
+{
+    ProcessEventType type;
+    pid_t pid;          // İlgili process (LOCK_RECOVERED: ölü sahip, 0 = bilinmiyor)
+    pid_t sender_pid;   // REMOTE_*: gönderen terminal
+    int command;        // UNKNOWN_COMMAND: komut kodu
+    int count;          // REMOTE_BATCH: hedef sayısı
+    int exited_count;   // REMOTE_BATCH: zaten çıkmış olanlar
+    int signal;         // WATCHDOG/REMOTE_TERMINATE: gönderilen sinyal (0: gönderilmedi)
+    int error;          // REMOTE_TERMINATE: sinyal hatası (errno, 0: yok)
+    int exited;         // REMOTE_TERMINATE: process zaten çıkmış, kayıt güncellendi
+    int reaped;         // EXITED: 1 = waitpid ile toplandı, 0 = kill(0) ile tespit edildi
+    const char *reason; // WATCHDOG: neden (statik metin)
+} ProcessEvent;
+
+// Tutarlı tablo görüntüsü (kopyasız)
+typedef struct
+{
+    const SharedData *table; // Paylaşılan belleğe doğrudan işaretçi
+    unsigned int seq;        // Başlangıçtaki seqlock değeri
+    int index;               // Sıradaki slot
+} ProcessSnapshot;
+
+typedef struct procx procx_t;                 // Terminal tanıtıcısı
+typedef struct procx_subscription procx_sub_t; // Olay aboneliği
+
+// --- API ---
+
+// Namespace'e bağlan (NULL/"" = varsayılan), terminali kaydet ve thread'leri başlat. Hata: NULL + errno
+procx_t *procx_open(const char *ns);
+// Thread'leri durdur, attached processleri sonlandır, kaydı sil. Kalan terminal sayısını döndürür
+// (0: son terminal, kaynaklar kaldırıldı), hata: -1
+int procx_close(procx_t *h);
+
+// Process başlat (beklemez). Hata: -1 + errno (ENOSPC: tablo dolu, EINVAL: geçersiz cgroup ayarı;
+// etiket '/', ".", ".." içeremez ve "job-" ile başlayamaz)
+pid_t procx_spawn(procx_t *h, const ProcessSpec *spec);
+// Bu terminalin başlattığı process'in çıkmasını bekle ve tabloyu güncelle. waitpid durumunu döndürür
+// (bekleme sinyalle kesilirse tabloya dokunmadan -1 + EINTR; process hâlâ çalışıyor olabilir).
+// Grupta üye kalırsa (ör. "cmd &") kayıt grup boşalana kadar PROCX_RUNNING kalır, çıkışı monitor onaylar
+int procx_wait(procx_t *h, pid_t pid);
+// Seçiciyle eşleşenlere tek kilit altında SIGTERM gönder, diğer terminallere tek bildirim yolla.
+// Sinyallenen PID'ler pids'e (en az PROCX_MAX_PROCESSES eleman) yazılır, sayısı döndürülür
+// (hiçbiri sinyallenemediyse -1 + errno)
+int procx_kill(procx_t *h, const ProcessSelector *sel, pid_t *pids);
+// PID'e ait kaydı kopyala. Bulunamazsa -1
+int procx_find(procx_t *h, pid_t pid, ProcessInfo *out);
+
+// Kopyasız okuma: begin -> next ... -> end. end() -1 döndürürse okunanlar tutarsızdır, tekrar deneyin
+void procx_snapshot_begin(procx_t *h, ProcessSnapshot *snap);
+const ProcessInfo *procx_snapshot_next(ProcessSnapshot *snap);
+int procx_snapshot_end(const ProcessSnapshot *snap);
+
+// Olay aboneliği. procx_next_event: 1 = olay var, 0 = zaman aşımı (timeout_ms < 0: sonsuz bekle)
+procx_sub_t *procx_subscribe(procx_t *h);
+int procx_next_event(procx_sub_t *sub, ProcessEvent *ev, int timeout_ms);
+void procx_unsubscribe(procx_sub_t *sub);
+
+// Çok adımlı tutarlı okumalar için tablo kilidi (sahibi ölürse diğer terminaller devralır).
+// Sadece okuma içindir; seqlock sayacına dokunmaz, kopyasız okuyucuları bekletmez.
+void procx_lock(procx_t *h);
+void procx_unlock(procx_t *h);
+const SharedData *procx_table(procx_t *h);
+
+// cgroup v2 kök dizini (PROCX_CGROUP_ROOT ile değiştirilebilir)
+const char *procx_cgroup_root(void);
+
+#endif // PROCX_H
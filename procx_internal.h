@@ -0,0 +1,67 @@
+#ifndef PROCX_INTERNAL_H
+#define PROCX_INTERNAL_H
+
+// libprocx iç yapıları - sadece kütüphane ve stres aracı tarafından kullanılır
+
+#include <pthread.h>   // pthread_t, pthread_mutex_t
+#include <semaphore.h> // sem_t
+#include <stddef.h>    // offsetof
+#include "procx.h"
+
+// Mesaj Komutları
+#define CMD_START 1
+#define CMD_TERMINATE 2
+#define CMD_TERMINATE_BATCH 3 // Toplu sonlandırma (PID listesi mesajın içinde)
+
+#define EVENT_QUEUE_SIZE 64 // Abone başına bekleyen olay sayısı
+
+// Mesaj yapısı
+typedef struct
+{
+    long msg_type;                 // Mesaj tipi
+    int command;                   // Komut (START/TERMINATE/TERMINATE_BATCH)
+    pid_t sender_pid;              // Gönderen PID
+    pid_t target_pid;              // Hedef process PID
+    int target_count;              // TERMINATE_BATCH için hedef sayısı
+    pid_t targets[PROCX_MAX_PROCESSES];  // TERMINATE_BATCH hedef PID listesi
+} Message;
+
+// Terminal tanıtıcısı
+struct procx
+{
+    SharedData *shared_data;  // Paylaşılan bellek işaretçisi
+    sem_t *sem;               // Semaphore işaretçisi
+    int msqid;                // Message Queue ID
+    char shm_name[64];        // Namespace'e göre Shared Memory adı
+    char sem_name[64];        // Namespace'e göre Semaphore adı
+    char mq_key_file[128];    // Namespace'e göre ftok dosyası
+    volatile int running;     // Thread döngü kontrolü
+    pthread_t monitor_tid;
+    pthread_t watchdog_tid;
+    pthread_t ipc_listener_tid;
+    pthread_mutex_t sub_lock; // Abone listesi kilidi
+    procx_sub_t *subs;        // Olay aboneleri
+    int leaf_seq;             // Süreç başına cgroup yaprak sayacı
+    pid_t fg_job;             // Terminal ön planını tutan attached iş (0: yok)
+    int pidfds[PROCX_MAX_PROCESSES];     // Slot başına başlattığımız işin pidfd'si (-1: yok, kilit altında)
+    pid_t pidfd_pids[PROCX_MAX_PROCESSES]; // pidfd'nin ait olduğu PID
+};
+
+// Olay aboneliği (halka tampon)
+struct procx_subscription
+{
+    procx_t *h;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    ProcessEvent events[EVENT_QUEUE_SIZE];
+    int head;  // En eski olay
+    int count; // Bekleyen olay sayısı
+    procx_sub_t *next;
+};
+
+static inline size_t message_size(const Message *msg) // Sadece kullanılan hedef listesini gönder (kuyrukta daha az yer kaplar)
+{
+    return offsetof(Message, targets) - sizeof(long) + msg->target_count * sizeof(pid_t);
+}
+
+#endif // PROCX_INTERNAL_H
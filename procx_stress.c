@@ -0,0 +1,657 @@
+#define _POSIX_C_SOURCE 200809L // POSIX.1-2008 standardını etkinleştir
+#define _DEFAULT_SOURCE         // usleep için gerekli
+#include <stdio.h>     // fprintf, perror
+#include <stdlib.h>    // rand_r
+#include <string.h>    // memset
+#include <unistd.h>    // fork, pipe, sleep
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap (worker sayaçları)
+#include <sys/msg.h>   // msgsnd (kuyruk doldurma)
+#include <sys/wait.h>  // waitpid
+#include <sys/prctl.h> // PR_SET_CHILD_SUBREAPER
+#include <errno.h>     // error handling
+#include <time.h>      // clock_gettime
+#include <signal.h>    // kill, SIGKILL
+#include <dirent.h>    // opendir (/proc taraması)
+#include <pthread.h>   // pthread_create (öksüz toplayıcı)
+#include "procx_internal.h" // Hata enjeksiyonu için kütüphane iç yapıları (msqid, Message)
+
+// Çok terminalli stres ve hata enjeksiyonu aracı (./procx_stress [seed] [terminal_sayısı]).
+// procx arayüzünden ayrı derlenir: kuyruk hatasını üretmek için procx.h dışındaki iç yapılara erişir.
+
+#define STRESS_DEFAULT_TERMINALS 16 // Varsayılan terminal sayısı
+#define STRESS_MAX_TERMINALS 64    // Stres modunda maksimum terminal sayısı
+#define STRESS_PHASES 3            // Temel, hata 1, hata 2
+#define STRESS_PHASE_OPS 1000      // Worker başına her fazdaki işlem sayısı
+#define STRESS_BUCKET_MS 100       // Verim ölçüm aralığı (milisaniye)
+#define STRESS_PHASE_BUCKETS 300   // Faz başına ölçülen aralık sayısı (30 saniye)
+#define STRESS_TRACE_OPS (STRESS_PHASES * STRESS_PHASE_OPS) // Worker başına işlem kaydı (tamamı)
+#define STRESS_RECENT_SPAWNS 8     // K işlemi worker'ın son kaç başlatmasından birini hedefler
+
+// Worker işlem kaydı (S: başlat, L: listele, K: tek sonlandır, B: toplu sonlandır)
+typedef struct
+{
+    long t_ms;  // Fazın başlangıcından itibaren
+    char op;
+    int k;      // S/K: worker'ın başarılı başlatma sırası (-1: yok), B: sleep süresi, L: -1
+    pid_t pid;  // S: başlatılan PID (-1: hata), K: hedef PID (-1: hedef yok), L/B: 0
+    int result; // S: errno, L: aktif sayısı, K/B: procx_kill dönüşü
+} StressOp;
+
+// Worker terminallerin verim sayaçları (fork öncesi paylaşımlı anonim bellek)
+typedef struct
+{
+    volatile int phase_go;                            // Bu değerden küçük fazlar başlayabilir
+    volatile int arrived[STRESS_PHASES];              // Fazını bitirip bariyere ulaşan worker sayısı
+    volatile int release;                             // Worker'lar kapansın (drain bittikten sonra)
+    volatile int reaper_stop;                         // Öksüz toplayıcı dursun
+    struct timespec phase_start[STRESS_PHASES];       // Fazların başlama anı
+    long phase_ms[STRESS_PHASES];                     // Son worker'ın fazı bitirdiği an
+    long ops[STRESS_MAX_TERMINALS][STRESS_PHASES][STRESS_PHASE_BUCKETS]; // Aralık başına tamamlanan işlem sayısı
+    int trace_len[STRESS_MAX_TERMINALS];              // Kaydedilen işlem sayısı
+    StressOp trace[STRESS_MAX_TERMINALS][STRESS_TRACE_OPS]; // Worker başına işlem kaydı
+} StressStats;
+
+char stress_ns[32]; // Canlı ProcX örneklerinden yalıtılmış namespace
+
+long elapsed_ms(const struct timespec *since) // Verilen andan bu yana geçen süre (ms)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - since->tv_sec) * 1000 + (now.tv_nsec - since->tv_nsec) / 1000000;
+}
+
+void silence_output() // Terminal çıktısını /dev/null'a yönlendir
+{
+    int devnull = open("/dev/null", O_WRONLY);
+    if (devnull != -1)
+    {
+        dup2(devnull, STDOUT_FILENO);
+        dup2(devnull, STDERR_FILENO);
+        close(devnull);
+    }
+}
+
+int collect_active(procx_t *h, pid_t *pids, int *retries) // Aktif PID'leri kopyasız okumayla topla
+{
+    ProcessSnapshot snap;
+    int count;
+
+    *retries = -1;
+    do
+    {
+        count = 0;
+        (*retries)++;
+        procx_snapshot_begin(h, &snap);
+        const ProcessInfo *proc;
+        while ((proc = procx_snapshot_next(&snap)) != NULL)
+            pids[count++] = proc->pid;
+    } while (procx_snapshot_end(&snap) == -1); // Yazma ile çakıştı, tekrar oku
+    return count;
+}
+
+void stress_worker(int id, unsigned int seed, StressStats *stats) // Seed'e bağlı start/list/terminate yükü üreten terminal
+{
+    // Her worker'ın işlem dizisi ve hata noktaları yalnızca seed'e bağlıdır: fazlar sabit işlem sayısıyla
+    // biter ve hatalar tüm worker'lar bariyerdeyken enjekte edilir. K hedefi paylaşılan tablodan değil
+    // worker'ın kendi başlatma sırasından seçilir; hangi başlatmanın yer bulduğu tablo doluluğuna bağlıdır
+    unsigned int rng = seed * 2654435761u + id;
+    pid_t spawned[STRESS_TRACE_OPS]; // Worker'ın başarılı başlatmaları sırasıyla
+    int spawned_count = 0;
+
+    procx_t *h = procx_open(stress_ns);
+    if (h == NULL)
+    {
+        for (int phase = 0; phase < STRESS_PHASES; phase++) // Bariyerler beklemesin
+            __sync_fetch_and_add(&stats->arrived[phase], 1);
+        _exit(1);
+    }
+
+    for (int phase = 0; phase < STRESS_PHASES; phase++)
+    {
+        while (stats->phase_go <= phase) // Harness fazı başlatana (ve hatayı enjekte edene) kadar bekle
+            usleep(1000);
+        __sync_synchronize();
+
+        for (int n = 0; n < STRESS_PHASE_OPS; n++)
+        {
+            int op = rand_r(&rng) % 100;
+            StressOp rec = {0, 0, -1, 0, 0};
+
+            if (op < 40) // Yeni process başlat (bir kısmı SIGTERM'i yok sayar, bir kısmının süre bütçesi var)
+            {
+                char command[64];
+                ProcessSpec spec;
+                memset(&spec, 0, sizeof(spec));
+                int duration = 1 + rand_r(&rng) % 6;
+
+                if (rand_r(&rng) % 100 < 15)
+                    snprintf(command, sizeof(command), "trap '' TERM; sleep %d", duration);
+                else
+                    snprintf(command, sizeof(command), "sleep %d", duration);
+                if (rand_r(&rng) % 100 < 20)
+                    spec.limits.wall_sec = 2;
+
+                spec.command = command;
+                spec.mode = PROCX_DETACHED;
+                rec.op = 'S';
+                rec.pid = procx_spawn(h, &spec);
+                rec.result = rec.pid == -1 ? errno : 0;
+                if (rec.pid != -1)
+                {
+                    rec.k = spawned_count;
+                    spawned[spawned_count++] = rec.pid;
+                }
+            }
+            else if (op < 65) // Listele
+            {
+                pid_t pids[PROCX_MAX_PROCESSES];
+                int retries;
+                rec.op = 'L';
+                rec.result = collect_active(h, pids, &retries);
+            }
+            else if (op < 95) // Kendi son başlatmalarından birini sonlandır
+            {
+                int recent = spawned_count < STRESS_RECENT_SPAWNS ? spawned_count : STRESS_RECENT_SPAWNS;
+                int back = rand_r(&rng) % (recent > 0 ? recent : 1); // Hedef olmasa da rng aynı ilerlesin
+
+                rec.op = 'K';
+                rec.pid = -1;
+                if (recent > 0)
+                {
+                    rec.k = spawned_count - 1 - back;
+                    rec.pid = spawned[rec.k];
+                    ProcessSelector sel;
+                    pid_t pids[PROCX_MAX_PROCESSES];
+                    memset(&sel, 0, sizeof(sel));
+                    sel.type = PROCX_SELECT_PID;
+                    sel.pid = rec.pid;
+                    rec.result = procx_kill(h, &sel, pids); // Hedef çoktan çıkmışsa 0
+                }
+            }
+            else // Toplu sonlandırma: belirli süreli tüm sleep'ler (tüm terminallerin)
+            {
+                ProcessSelector sel;
+                pid_t pids[PROCX_MAX_PROCESSES];
+                memset(&sel, 0, sizeof(sel));
+                rec.op = 'B';
+                rec.k = 1 + rand_r(&rng) % 6;
+                sel.type = PROCX_SELECT_COMMAND;
+                snprintf(sel.pattern, sizeof(sel.pattern), "*sleep %d", rec.k);
+                rec.result = procx_kill(h, &sel, pids);
+            }
+
+            rec.t_ms = elapsed_ms(&stats->phase_start[phase]);
+            if (stats->trace_len[id] < STRESS_TRACE_OPS)
+                stats->trace[id][stats->trace_len[id]++] = rec;
+
+            long bucket = rec.t_ms / STRESS_BUCKET_MS;
+            if (bucket >= 0 && bucket < STRESS_PHASE_BUCKETS)
+                stats->ops[id][phase][bucket]++;
+
+            usleep(rand_r(&rng) % 5000); // Kullanıcı düşünme süresi
+        }
+        __sync_fetch_and_add(&stats->arrived[phase], 1);
+    }
+
+    // Drain sırasında monitor/watchdog thread'leri çalışmaya devam etsin
+    while (!stats->release)
+        usleep(10000);
+
+    procx_close(h); // Ölü terminalleri ve bekleyen mesajlarını da temizler
+    _exit(0);
+}
+
+pid_t spawn_victim(int hold_lock) // Kayıtlı bir terminal başlat; istenirse kilidi tutarken beklesin
+{
+    int ready[2];
+    char byte = 0;
+
+    if (pipe(ready) == -1)
+        return -1;
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        procx_t *h = procx_open(stress_ns);
+        if (h == NULL)
+            _exit(1);
+        if (hold_lock)
+            procx_lock(h); // Kilidi tut ve asla bırakma
+        if (write(ready[1], &byte, 1) != 1)
+            _exit(1);
+        pause();
+        _exit(0);
+    }
+
+    close(ready[1]);
+    if (pid > 0 && read(ready[0], &byte, 1) != 1)
+        pid = -1;
+    close(ready[0]);
+    return pid;
+}
+
+void start_phase(StressStats *stats, int phase) // Bariyerde bekleyen worker'ları bir sonraki faza geçir
+{
+    clock_gettime(CLOCK_MONOTONIC, &stats->phase_start[phase]);
+    __sync_synchronize();
+    stats->phase_go = phase + 1;
+}
+
+int wait_phase(StressStats *stats, int phase, int terminals) // Tüm worker'lar fazın işlemlerini bitirene kadar bekle
+{
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (stats->arrived[phase] < terminals)
+    {
+        if (elapsed_ms(&start) > 120000)
+            break;
+        usleep(1000);
+    }
+    stats->phase_ms[phase] = elapsed_ms(&stats->phase_start[phase]);
+    return stats->arrived[phase] < terminals ? -1 : 0;
+}
+
+long inject_lock_holder_kill(procx_t *h, StressStats *stats, int phase) // Kilidi tutan terminali SIGKILL ile öldür, fazı başlat, herhangi bir terminalin kilidi devralma süresini ölç (µs)
+{
+    const SharedData *shared_data = procx_table(h);
+    pid_t victim = spawn_victim(1);
+    if (victim == -1)
+    {
+        start_phase(stats, phase);
+        return -1;
+    }
+
+    unsigned int recoveries = shared_data->lock_recoveries;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    kill(victim, SIGKILL); // Worker'lar bariyerde: hata her koşuda aynı işlem sırasına denk gelir
+    start_phase(stats, phase); // Kilidi ilk isteyen terminal (worker ya da monitor thread'i) devralır
+
+    while (shared_data->lock_recoveries == recoveries)
+    {
+        if (elapsed_ms(&start) > 15000)
+            return -1;
+        usleep(100);
+    }
+    __sync_synchronize();
+    struct timespec at = shared_data->lock_recovered_at;
+    return (at.tv_sec - start.tv_sec) * 1000000L + (at.tv_nsec - start.tv_nsec) / 1000;
+}
+
+long inject_full_queue(procx_t *h, StressStats *stats, int phase, int *filled) // Ölü bir terminal adına kuyruğu doldur, fazı başlat, tekrar mesaj gönderilebilene kadar geçen süreyi ölç
+{
+    pid_t victim = spawn_victim(0);
+    if (victim == -1)
+    {
+        start_phase(stats, phase);
+        return -1;
+    }
+
+    procx_lock(h); // Kuyruk dolana kadar başka terminal ölü terminali temizlemesin
+    kill(victim, SIGKILL); // Temizlik yapmadan öldü, active_terminals'da kaldı
+    waitpid(victim, NULL, 0);
+
+    Message msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_type = victim;
+    msg.sender_pid = getpid();
+    *filled = 0;
+    while (msgsnd(h->msqid, &msg, message_size(&msg), IPC_NOWAIT) == 0)
+        (*filled)++;
+    procx_unlock(h);
+    start_phase(stats, phase); // Kuyruğu worker'ların yükü boşaltır
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    msg.msg_type = getpid(); // Kendi dinleyicimize deneme mesajı (kendi mesajımız olduğu için yok sayılır)
+    while (msgsnd(h->msqid, &msg, message_size(&msg), IPC_NOWAIT) == -1)
+    {
+        if (elapsed_ms(&start) > 15000)
+            return -1;
+        usleep(10000);
+    }
+    return elapsed_ms(&start);
+}
+
+int check_invariants(procx_t *h, FILE *out, const char *label, int expect_empty) // Paylaşılan tablo tutarlılığını doğrula
+{
+    const SharedData *shared_data = procx_table(h);
+    int violations = 0;
+
+    procx_lock(h);
+    if (shared_data->lock_owner != getpid())
+    {
+        fprintf(out, "  [%s] lock owner is %d, expected %d\n", label, shared_data->lock_owner, getpid());
+        violations++;
+    }
+    if (shared_data->seq & 1) // Sadece okuyan kilit sayacı tek yapmamalı
+    {
+        fprintf(out, "  [%s] seq=%u is odd under a read-only lock\n", label, shared_data->seq);
+        violations++;
+    }
+
+    int terminals = 0;
+    for (int i = 0; i < PROCX_MAX_TERMINALS; i++)
+        if (shared_data->active_terminals[i] != 0)
+            terminals++;
+    if (terminals != shared_data->terminal_count)
+    {
+        fprintf(out, "  [%s] terminal_count=%d but %d terminals registered\n", label, shared_data->terminal_count, terminals);
+        violations++;
+    }
+
+    for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+    {
+        const ProcessInfo *proc = &shared_data->processes[i];
+        if (!proc->is_active)
+            continue;
+        if (expect_empty)
+        {
+            fprintf(out, "  [%s] slot %d (PID %d) still active after drain\n", label, i, proc->pid);
+            violations++;
+        }
+        if (proc->status != PROCX_RUNNING)
+        {
+            fprintf(out, "  [%s] slot %d (PID %d) active but not RUNNING\n", label, i, proc->pid);
+            violations++;
+        }
+        for (int j = i + 1; j < PROCX_MAX_PROCESSES; j++)
+        {
+            if (shared_data->processes[j].is_active && shared_data->processes[j].pid == proc->pid)
+            {
+                fprintf(out, "  [%s] PID %d recorded in slots %d and %d\n", label, proc->pid, i, j);
+                violations++;
+            }
+        }
+    }
+    procx_unlock(h);
+    return violations;
+}
+
+double report_phase(FILE *out, StressStats *stats, int terminals, int phase, const char *label, double baseline) // Faz verimini ve toparlanma süresini yazdır
+{
+    long phase_ms = stats->phase_ms[phase] > 0 ? stats->phase_ms[phase] : 1;
+    int buckets = phase_ms / STRESS_BUCKET_MS; // Son (yarım) aralık toparlanma için sayılmaz
+    long total = 0;
+    int recovered_at = -1;
+
+    if (buckets > STRESS_PHASE_BUCKETS)
+        buckets = STRESS_PHASE_BUCKETS;
+    for (int b = 0; b < STRESS_PHASE_BUCKETS; b++)
+    {
+        long ops = 0;
+        for (int t = 0; t < terminals; t++)
+            ops += stats->ops[t][phase][b];
+        total += ops;
+        // Verim, temel verimin %80'ine döndüğünde toparlanmış say
+        if (b < buckets && recovered_at == -1 && baseline > 0 && ops * (1000.0 / STRESS_BUCKET_MS) >= 0.8 * baseline)
+            recovered_at = b * STRESS_BUCKET_MS;
+    }
+
+    double rate = total * 1000.0 / phase_ms;
+    fprintf(out, "  %-18s %9.1f ops/s in %5ld ms", label, rate, phase_ms);
+    if (baseline > 0)
+    {
+        fprintf(out, "  %+6.1f%%", (rate - baseline) * 100.0 / baseline);
+        if (recovered_at >= 0)
+            fprintf(out, "  throughput recovered in %d ms", recovered_at);
+        else
+            fprintf(out, "  throughput not recovered");
+    }
+    fprintf(out, "\n");
+    return rate;
+}
+
+void *orphan_reaper(void *arg) // Subreaper olarak bize bağlanan öksüzleri sürekli topla
+{
+    StressStats *stats = arg;
+
+    // libprocx sadece kendi başlattığı PID'leri toplar; shell'i ölen işin komutu buraya bağlanır ve
+    // toplanmazsa zombi olarak process grubunu canlı tutar. Worker ve kurbanlar da burada toplanabilir,
+    // onları bekleyen waitpid çağrıları çıkıştan sonra ECHILD ile döner.
+    while (!stats->reaper_stop)
+    {
+        if (waitpid(-1, NULL, WNOHANG) <= 0)
+            usleep(10000);
+    }
+    return NULL;
+}
+
+int reap_descendants(void) // Bize bağlanan tüm alt processleri gruplarıyla öldür ve topla
+{
+    int leaked = 0;
+
+    for (;;)
+    {
+        int found = 0;
+        DIR *dir = opendir("/proc");
+        struct dirent *entry;
+
+        while (dir != NULL && (entry = readdir(dir)) != NULL)
+        {
+            char path[300], buf[512];
+            snprintf(path, sizeof(path), "/proc/%s/stat", entry->d_name);
+            FILE *fp = fopen(path, "r");
+            if (fp == NULL)
+                continue;
+            size_t n = fread(buf, 1, sizeof(buf) - 1, fp);
+            fclose(fp);
+            buf[n] = '\0';
+
+            char *p = strrchr(buf, ')'); // Komut adı boşluk içerebilir
+            char state;
+            pid_t pid = atoi(buf), ppid, pgrp;
+            if (p == NULL || sscanf(p + 2, "%c %d %d", &state, &ppid, &pgrp) != 3 || ppid != getpid())
+                continue;
+
+            found++;
+            if (state != 'Z') // Hâlâ çalışan process sızıntıdır
+            {
+                leaked++;
+                if (pgrp != getpgrp())
+                    kill(-pgrp, SIGKILL);
+                kill(pid, SIGKILL);
+            }
+        }
+        if (dir != NULL)
+            closedir(dir);
+
+        while (waitpid(-1, NULL, found ? 0 : WNOHANG) > 0) // Subreaper olarak torunları da topla
+            ;
+        if (found == 0)
+            break;
+    }
+    return leaked;
+}
+
+int write_trace(const char *path, StressStats *stats, int terminals) // Worker işlem kayıtlarını dosyaya yaz
+{
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL)
+        return -1;
+
+    int total = 0;
+    fprintf(fp, "# worker phase n t_ms op k pid result (S: start, L: list, K: kill one, B: bulk kill)\n");
+    fprintf(fp, "# k: S/K = index among the worker's successful spawns, B = sleep duration; t_ms is relative to the phase start\n");
+    for (int t = 0; t < terminals; t++)
+    {
+        for (int i = 0; i < stats->trace_len[t]; i++)
+        {
+            StressOp *rec = &stats->trace[t][i];
+            fprintf(fp, "%d %d %d %ld %c %d %d %d\n", t, i / STRESS_PHASE_OPS, i % STRESS_PHASE_OPS,
+                    rec->t_ms, rec->op, rec->k, rec->pid, rec->result);
+        }
+        total += stats->trace_len[t];
+    }
+    fclose(fp);
+    return total;
+}
+
+int run_stress(unsigned int seed, int terminals) // Çok terminalli stres ve hata enjeksiyonu testi
+{
+    if (terminals < 1)
+        terminals = 1;
+    if (terminals > STRESS_MAX_TERMINALS)
+        terminals = STRESS_MAX_TERMINALS;
+
+    FILE *out = fdopen(dup(STDOUT_FILENO), "w"); // Rapor için orijinal stdout
+    if (out == NULL)
+    {
+        perror("fdopen failed");
+        return 1;
+    }
+    setvbuf(out, NULL, _IOLBF, 0);
+
+    snprintf(stress_ns, sizeof(stress_ns), "stress-%d", getpid()); // Canlı ProcX örneklerine dokunma
+
+    fprintf(out, "ProcX stress: seed=%u terminals=%d phase=%d ops/terminal namespace=%s\n", seed, terminals, STRESS_PHASE_OPS, stress_ns);
+
+    StressStats *stats = mmap(NULL, sizeof(StressStats), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (stats == MAP_FAILED)
+    {
+        perror("mmap failed");
+        return 1;
+    }
+    memset(stats, 0, sizeof(StressStats));
+
+    procx_t *h = procx_open(stress_ns);
+    if (h == NULL)
+    {
+        perror("procx_open failed");
+        return 1;
+    }
+    char key_file[sizeof(h->mq_key_file)];
+    snprintf(key_file, sizeof(key_file), "%s", h->mq_key_file);
+
+    silence_output(); // Başlatılan komutların çıktısı rapora karışmasın
+    prctl(PR_SET_CHILD_SUBREAPER, 1); // Öksüz kalan detached processler bize bağlansın ve toplanabilsin
+
+    pid_t workers[STRESS_MAX_TERMINALS];
+    for (int i = 0; i < terminals; i++)
+    {
+        workers[i] = fork();
+        if (workers[i] == 0)
+            stress_worker(i, seed, stats);
+    }
+    pthread_t reaper_tid;
+    pthread_create(&reaper_tid, NULL, orphan_reaper, stats);
+
+    // Hata sırası seed'e bağlı; hatalar fazlar arasındaki bariyerde, tüm worker'lar beklerken enjekte edilir
+    int lock_first = (seed & 1) == 0;
+    long lock_us = -1, queue_ms = -1;
+    int filled = 0;
+    int violations = 0;
+
+    start_phase(stats, 0);
+    for (int phase = 1; phase <= STRESS_PHASES; phase++)
+    {
+        if (wait_phase(stats, phase - 1, terminals) == -1)
+        {
+            fprintf(out, "  [phase %d] only %d of %d terminals finished\n", phase - 1, stats->arrived[phase - 1], terminals);
+            violations++;
+        }
+        if (phase == STRESS_PHASES)
+            break;
+        violations += check_invariants(h, out, phase == 1 ? "before fault 1" : "before fault 2", 0);
+        if ((phase == 1) == lock_first)
+            lock_us = inject_lock_holder_kill(h, stats, phase);
+        else
+            queue_ms = inject_full_queue(h, stats, phase, &filled);
+    }
+
+    // SIGTERM'i yok sayan uzun süreli processler ekle; drain sırasında watchdog SIGKILL ile bitirmeli
+    ProcessSpec stubborn;
+    memset(&stubborn, 0, sizeof(stubborn));
+    stubborn.command = "trap '' TERM; sleep 60";
+    stubborn.mode = PROCX_DETACHED;
+    for (int i = 0; i < 4; i++)
+        procx_spawn(h, &stubborn);
+
+    // Tüm processleri sonlandır
+    ProcessSelector sel;
+    pid_t pids[PROCX_MAX_PROCESSES];
+    memset(&sel, 0, sizeof(sel));
+    sel.type = PROCX_SELECT_ALL;
+
+    const SharedData *shared_data = procx_table(h);
+    struct timespec drain_start;
+    clock_gettime(CLOCK_MONOTONIC, &drain_start);
+    int drained = procx_kill(h, &sel, pids);
+    int remaining = 1;
+    int escalated = 0;
+    while (remaining > 0 && elapsed_ms(&drain_start) < (PROCX_GRACE_PERIOD + 10) * 1000L)
+    {
+        usleep(100000);
+        remaining = 0;
+        int killed = 0;
+        procx_lock(h);
+        for (int i = 0; i < PROCX_MAX_PROCESSES; i++)
+        {
+            if (!shared_data->processes[i].is_active)
+                continue;
+            remaining++;
+            if (shared_data->processes[i].kill_sent)
+                killed++;
+        }
+        procx_unlock(h);
+        if (killed > escalated)
+            escalated = killed;
+    }
+    long drain_ms = elapsed_ms(&drain_start);
+
+    stats->release = 1;
+    for (int i = 0; i < terminals; i++)
+        waitpid(workers[i], NULL, 0);
+
+    violations += check_invariants(h, out, "after drain", 1);
+
+    stats->reaper_stop = 1;
+    pthread_join(reaper_tid, NULL);
+    int leaked = reap_descendants(); // Hiçbir alt process harness'ten uzun yaşamasın
+    if (leaked > 0)
+    {
+        fprintf(out, "  descendants: %d process(es) still running after drain (killed)\n", leaked);
+        violations++;
+    }
+
+    // Rapor
+    fprintf(out, "Throughput:\n");
+    double baseline = report_phase(out, stats, terminals, 0, "baseline", 0.0);
+    report_phase(out, stats, terminals, lock_first ? 1 : 2, "after lock kill", baseline);
+    report_phase(out, stats, terminals, lock_first ? 2 : 1, "after queue full", baseline);
+
+    fprintf(out, "Faults:\n");
+    fprintf(out, "  SIGKILL while holding lock: %s", lock_us >= 0 ? "lock recovered by a terminal " : "lock NOT recovered");
+    if (lock_us >= 0)
+        fprintf(out, "%.2f ms after SIGKILL", lock_us / 1000.0);
+    fprintf(out, "\n  full message queue (%d msgs): %s", filled, queue_ms >= 0 ? "queue drained in " : "queue NOT drained");
+    if (queue_ms >= 0)
+        fprintf(out, "%ld ms", queue_ms);
+    fprintf(out, "\n  drain: %d process(es) signalled, %s in %ld ms (%d escalated to SIGKILL)\n",
+            drained, remaining == 0 ? "all exits confirmed" : "NOT all exited", drain_ms, escalated);
+
+    if (lock_us < 0 || queue_ms < 0 || remaining > 0)
+        violations++;
+    fprintf(out, "Invariants: %s (%d violation(s))\n", violations == 0 ? "OK" : "FAILED", violations);
+    char trace_file[64];
+    snprintf(trace_file, sizeof(trace_file), "procx-stress-%d.trace", getpid());
+    int traced = write_trace(trace_file, stats, terminals);
+    if (traced >= 0)
+        fprintf(out, "Trace: %s (%d ops)\n", trace_file, traced);
+    // Aynı seed aynı işlem dizisini, hedef sıralarını ve hata noktalarını verir; süreçlerin çıkış zamanı ve sonuçlar değişebilir
+    fprintf(out, "Seed: ./procx_stress %u %d (same ops, spawn-index targets and fault points; results may differ)\n", seed, terminals);
+
+    procx_close(h);
+    unlink(key_file);
+    munmap(stats, sizeof(StressStats));
+    fclose(out);
+    return violations == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) // ./procx_stress [seed] [terminal_sayısı]
+{
+    unsigned int seed = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : (unsigned int)time(NULL);
+    int terminals = (argc > 2) ? atoi(argv[2]) : STRESS_DEFAULT_TERMINALS;
+    return run_stress(seed, terminals);
+}